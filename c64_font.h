@@ -129,4 +129,352 @@ static const uint8_t font_8x8[256][8] = {
     [124] = {0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00},
     [125] = {0xE0, 0x30, 0x30, 0x1C, 0x30, 0x30, 0xE0, 0x00},
     [126] = {0x76, 0xDC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-};
\ No newline at end of file
+};
+
+/* Glyphs beyond ASCII, sorted by code point so they can be binary searched:
+ * Latin-1 and Latin Extended-A letters, punctuation, arrows, shapes, box
+ * drawing and block elements. Code points missing here draw as U+FFFD. */
+static const struct {
+    uint16_t code;
+    uint8_t glyph[8];
+} font_8x8_ext[] = {
+    {0x00A0, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* no-break space */
+    {0x00A1, {0x30, 0x00, 0x30, 0x30, 0x78, 0x78, 0x30, 0x00}}, /* ¡ */
+    {0x00A2, {0x00, 0x30, 0x78, 0xDC, 0xD0, 0xDC, 0x78, 0x30}}, /* ¢ */
+    {0x00A3, {0x38, 0x6C, 0x60, 0xF0, 0x60, 0x60, 0xFC, 0x00}}, /* £ */
+    {0x00A4, {0x00, 0xCC, 0x78, 0x48, 0x78, 0xCC, 0x00, 0x00}}, /* ¤ */
+    {0x00A5, {0xCC, 0xCC, 0x78, 0xFC, 0x30, 0xFC, 0x30, 0x00}}, /* ¥ */
+    {0x00A6, {0x30, 0x30, 0x30, 0x00, 0x30, 0x30, 0x30, 0x00}}, /* ¦ */
+    {0x00A7, {0x78, 0xC0, 0x78, 0xCC, 0x78, 0x0C, 0x78, 0x00}}, /* § */
+    {0x00A8, {0xCC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* ¨ */
+    {0x00A9, {0x3C, 0x42, 0x99, 0xA1, 0x99, 0x42, 0x3C, 0x00}}, /* © */
+    {0x00AA, {0x78, 0x0C, 0x7C, 0xCC, 0x7C, 0x00, 0xFC, 0x00}}, /* ª */
+    {0x00AB, {0x00, 0x36, 0x6C, 0xD8, 0x6C, 0x36, 0x00, 0x00}}, /* « */
+    {0x00AC, {0x00, 0x00, 0xFC, 0x0C, 0x0C, 0x00, 0x00, 0x00}}, /* ¬ */
+    {0x00AD, {0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00}}, /* soft hyphen */
+    {0x00AE, {0x3C, 0x42, 0xB9, 0xA5, 0xB9, 0xA9, 0x42, 0x3C}}, /* ® */
+    {0x00AF, {0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* ¯ */
+    {0x00B0, {0x70, 0xD8, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* ° */
+    {0x00B1, {0x30, 0x30, 0xFC, 0x30, 0x30, 0x00, 0xFC, 0x00}}, /* ± */
+    {0x00B2, {0xE0, 0x30, 0x60, 0xC0, 0xF0, 0x00, 0x00, 0x00}}, /* ² */
+    {0x00B3, {0xE0, 0x30, 0x60, 0x30, 0xE0, 0x00, 0x00, 0x00}}, /* ³ */
+    {0x00B4, {0x18, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* ´ */
+    {0x00B5, {0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xFA, 0xC0, 0xC0}}, /* µ */
+    {0x00B6, {0x7E, 0xF6, 0xF6, 0x76, 0x16, 0x16, 0x16, 0x00}}, /* ¶ */
+    {0x00B7, {0x00, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00, 0x00}}, /* · */
+    {0x00B8, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x30}}, /* ¸ */
+    {0x00B9, {0x60, 0xE0, 0x60, 0x60, 0xF0, 0x00, 0x00, 0x00}}, /* ¹ */
+    {0x00BA, {0x70, 0xD8, 0xD8, 0x70, 0x00, 0xF8, 0x00, 0x00}}, /* º */
+    {0x00BB, {0x00, 0xD8, 0x6C, 0x36, 0x6C, 0xD8, 0x00, 0x00}}, /* » */
+    {0x00BC, {0x82, 0x84, 0x88, 0x14, 0x2C, 0x5E, 0x84, 0x00}}, /* ¼ */
+    {0x00BD, {0x82, 0x84, 0x88, 0x16, 0x22, 0x44, 0x8E, 0x00}}, /* ½ */
+    {0x00BE, {0xC2, 0x44, 0xC8, 0x14, 0x2C, 0x5E, 0x84, 0x00}}, /* ¾ */
+    {0x00BF, {0x18, 0x00, 0x18, 0x30, 0x60, 0x66, 0x3C, 0x00}}, /* ¿ */
+    {0x00C0, {0x60, 0x18, 0x30, 0x78, 0xCC, 0xFC, 0xCC, 0xCC}}, /* À */
+    {0x00C1, {0x0C, 0x30, 0x30, 0x78, 0xCC, 0xFC, 0xCC, 0xCC}}, /* Á */
+    {0x00C2, {0x30, 0xCC, 0x30, 0x78, 0xCC, 0xFC, 0xCC, 0xCC}}, /* Â */
+    {0x00C3, {0x76, 0xDC, 0x30, 0x78, 0xCC, 0xFC, 0xCC, 0xCC}}, /* Ã */
+    {0x00C4, {0xCC, 0x00, 0x30, 0x78, 0xCC, 0xFC, 0xCC, 0xCC}}, /* Ä */
+    {0x00C5, {0x78, 0x48, 0x30, 0x78, 0xCC, 0xFC, 0xCC, 0xCC}}, /* Å */
+    {0x00C6, {0x7E, 0xD8, 0xD8, 0xFC, 0xD8, 0xD8, 0xDE, 0x00}}, /* Æ */
+    {0x00C7, {0x3C, 0x66, 0xC0, 0xC0, 0xC0, 0x66, 0x3C, 0x30}}, /* Ç */
+    {0x00C8, {0x60, 0x18, 0xFE, 0x62, 0x78, 0x68, 0x62, 0xFE}}, /* È */
+    {0x00C9, {0x0C, 0x30, 0xFE, 0x62, 0x78, 0x68, 0x62, 0xFE}}, /* É */
+    {0x00CA, {0x30, 0xCC, 0xFE, 0x62, 0x78, 0x68, 0x62, 0xFE}}, /* Ê */
+    {0x00CB, {0xCC, 0x00, 0xFE, 0x62, 0x78, 0x68, 0x62, 0xFE}}, /* Ë */
+    {0x00CC, {0x60, 0x18, 0x78, 0x30, 0x30, 0x30, 0x30, 0x78}}, /* Ì */
+    {0x00CD, {0x0C, 0x30, 0x78, 0x30, 0x30, 0x30, 0x30, 0x78}}, /* Í */
+    {0x00CE, {0x30, 0xCC, 0x78, 0x30, 0x30, 0x30, 0x30, 0x78}}, /* Î */
+    {0x00CF, {0xCC, 0x00, 0x78, 0x30, 0x30, 0x30, 0x30, 0x78}}, /* Ï */
+    {0x00D0, {0xF8, 0x6C, 0x66, 0xF6, 0x66, 0x6C, 0xF8, 0x00}}, /* Ð */
+    {0x00D1, {0x76, 0xDC, 0xC6, 0xE6, 0xDE, 0xCE, 0xC6, 0xC6}}, /* Ñ */
+    {0x00D2, {0x60, 0x18, 0x38, 0x6C, 0xC6, 0xC6, 0x6C, 0x38}}, /* Ò */
+    {0x00D3, {0x0C, 0x30, 0x38, 0x6C, 0xC6, 0xC6, 0x6C, 0x38}}, /* Ó */
+    {0x00D4, {0x30, 0xCC, 0x38, 0x6C, 0xC6, 0xC6, 0x6C, 0x38}}, /* Ô */
+    {0x00D5, {0x76, 0xDC, 0x38, 0x6C, 0xC6, 0xC6, 0x6C, 0x38}}, /* Õ */
+    {0x00D6, {0xCC, 0x00, 0x38, 0x6C, 0xC6, 0xC6, 0x6C, 0x38}}, /* Ö */
+    {0x00D7, {0x00, 0xCC, 0x78, 0x30, 0x78, 0xCC, 0x00, 0x00}}, /* × */
+    {0x00D8, {0x3A, 0x6C, 0xCE, 0xD6, 0xE6, 0x6C, 0xB8, 0x00}}, /* Ø */
+    {0x00D9, {0x60, 0x18, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC}}, /* Ù */
+    {0x00DA, {0x0C, 0x30, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC}}, /* Ú */
+    {0x00DB, {0x30, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC}}, /* Û */
+    {0x00DC, {0xCC, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC}}, /* Ü */
+    {0x00DD, {0x0C, 0x30, 0xCC, 0xCC, 0x78, 0x30, 0x30, 0x78}}, /* Ý */
+    {0x00DE, {0xF0, 0x60, 0x7C, 0x66, 0x7C, 0x60, 0xF0, 0x00}}, /* Þ */
+    {0x00DF, {0x78, 0xCC, 0xCC, 0xD8, 0xCC, 0xCC, 0xD8, 0xC0}}, /* ß */
+    {0x00E0, {0x60, 0x18, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00}}, /* à */
+    {0x00E1, {0x0C, 0x30, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00}}, /* á */
+    {0x00E2, {0x30, 0xCC, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00}}, /* â */
+    {0x00E3, {0x76, 0xDC, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00}}, /* ã */
+    {0x00E4, {0xCC, 0x00, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00}}, /* ä */
+    {0x00E5, {0x78, 0x48, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00}}, /* å */
+    {0x00E6, {0x00, 0x00, 0x6C, 0x1A, 0x7E, 0xD8, 0x6E, 0x00}}, /* æ */
+    {0x00E7, {0x00, 0x00, 0x78, 0xCC, 0xC0, 0xCC, 0x78, 0x30}}, /* ç */
+    {0x00E8, {0x60, 0x18, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x00}}, /* è */
+    {0x00E9, {0x0C, 0x30, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x00}}, /* é */
+    {0x00EA, {0x30, 0xCC, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x00}}, /* ê */
+    {0x00EB, {0xCC, 0x00, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x00}}, /* ë */
+    {0x00EC, {0x60, 0x18, 0x70, 0x30, 0x30, 0x30, 0x78, 0x00}}, /* ì */
+    {0x00ED, {0x0C, 0x30, 0x70, 0x30, 0x30, 0x30, 0x78, 0x00}}, /* í */
+    {0x00EE, {0x30, 0xCC, 0x70, 0x30, 0x30, 0x30, 0x78, 0x00}}, /* î */
+    {0x00EF, {0xCC, 0x00, 0x70, 0x30, 0x30, 0x30, 0x78, 0x00}}, /* ï */
+    {0x00F0, {0x34, 0x18, 0x2C, 0x7C, 0xCC, 0xCC, 0x78, 0x00}}, /* ð */
+    {0x00F1, {0x76, 0xDC, 0xF8, 0xCC, 0xCC, 0xCC, 0xCC, 0x00}}, /* ñ */
+    {0x00F2, {0x60, 0x18, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0x00}}, /* ò */
+    {0x00F3, {0x0C, 0x30, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0x00}}, /* ó */
+    {0x00F4, {0x30, 0xCC, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0x00}}, /* ô */
+    {0x00F5, {0x76, 0xDC, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0x00}}, /* õ */
+    {0x00F6, {0xCC, 0x00, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0x00}}, /* ö */
+    {0x00F7, {0x00, 0x30, 0x00, 0xFC, 0x00, 0x30, 0x00, 0x00}}, /* ÷ */
+    {0x00F8, {0x00, 0x02, 0x7C, 0xCC, 0xDC, 0xEC, 0x78, 0x80}}, /* ø */
+    {0x00F9, {0x60, 0x18, 0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x00}}, /* ù */
+    {0x00FA, {0x0C, 0x30, 0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x00}}, /* ú */
+    {0x00FB, {0x30, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x00}}, /* û */
+    {0x00FC, {0xCC, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x00}}, /* ü */
+    {0x00FD, {0x0C, 0x30, 0xCC, 0xCC, 0xCC, 0x7C, 0x0C, 0xF8}}, /* ý */
+    {0x00FE, {0xE0, 0x60, 0x7C, 0x66, 0x66, 0x7C, 0x60, 0xF0}}, /* þ */
+    {0x00FF, {0xCC, 0x00, 0xCC, 0xCC, 0xCC, 0x7C, 0x0C, 0xF8}}, /* ÿ */
+    {0x0100, {0xFC, 0x00, 0x30, 0x78, 0xCC, 0xFC, 0xCC, 0xCC}}, /* Ā */
+    {0x0101, {0xFC, 0x00, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00}}, /* ā */
+    {0x0102, {0x84, 0x78, 0x30, 0x78, 0xCC, 0xFC, 0xCC, 0xCC}}, /* Ă */
+    {0x0103, {0x84, 0x78, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00}}, /* ă */
+    {0x0106, {0x0C, 0x30, 0x3C, 0x66, 0xC0, 0xC0, 0x66, 0x3C}}, /* Ć */
+    {0x0107, {0x0C, 0x30, 0x78, 0xCC, 0xC0, 0xCC, 0x78, 0x00}}, /* ć */
+    {0x010C, {0xCC, 0x30, 0x3C, 0x66, 0xC0, 0xC0, 0x66, 0x3C}}, /* Č */
+    {0x010D, {0xCC, 0x30, 0x78, 0xCC, 0xC0, 0xCC, 0x78, 0x00}}, /* č */
+    {0x010E, {0xCC, 0x30, 0xF8, 0x6C, 0x66, 0x66, 0x6C, 0xF8}}, /* Ď */
+    {0x010F, {0x1E, 0x0C, 0x0C, 0x7C, 0xCC, 0xCC, 0x76, 0x00}}, /* ď */
+    {0x0112, {0xFC, 0x00, 0xFE, 0x62, 0x78, 0x68, 0x62, 0xFE}}, /* Ē */
+    {0x0113, {0xFC, 0x00, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x00}}, /* ē */
+    {0x0116, {0x30, 0x00, 0xFE, 0x62, 0x78, 0x68, 0x62, 0xFE}}, /* Ė */
+    {0x0117, {0x30, 0x00, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x00}}, /* ė */
+    {0x011A, {0xCC, 0x30, 0xFE, 0x62, 0x78, 0x68, 0x62, 0xFE}}, /* Ě */
+    {0x011B, {0xCC, 0x30, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x00}}, /* ě */
+    {0x011E, {0x84, 0x78, 0x3C, 0x66, 0xC0, 0xCE, 0x66, 0x3E}}, /* Ğ */
+    {0x011F, {0x84, 0x78, 0x76, 0xCC, 0xCC, 0x7C, 0x0C, 0xF8}}, /* ğ */
+    {0x012A, {0xFC, 0x00, 0x78, 0x30, 0x30, 0x30, 0x30, 0x78}}, /* Ī */
+    {0x012B, {0xFC, 0x00, 0x70, 0x30, 0x30, 0x30, 0x78, 0x00}}, /* ī */
+    {0x0130, {0x30, 0x00, 0x78, 0x30, 0x30, 0x30, 0x30, 0x78}}, /* İ */
+    {0x0131, {0x00, 0x00, 0x70, 0x30, 0x30, 0x30, 0x78, 0x00}}, /* ı */
+    {0x0141, {0xF0, 0x60, 0x70, 0x60, 0x62, 0x66, 0xFE, 0x00}}, /* Ł */
+    {0x0142, {0x70, 0x30, 0x30, 0x3C, 0x30, 0x30, 0x78, 0x00}}, /* ł */
+    {0x0143, {0x0C, 0x30, 0xC6, 0xE6, 0xDE, 0xCE, 0xC6, 0xC6}}, /* Ń */
+    {0x0144, {0x0C, 0x30, 0xF8, 0xCC, 0xCC, 0xCC, 0xCC, 0x00}}, /* ń */
+    {0x0147, {0xCC, 0x30, 0xC6, 0xE6, 0xDE, 0xCE, 0xC6, 0xC6}}, /* Ň */
+    {0x0148, {0xCC, 0x30, 0xF8, 0xCC, 0xCC, 0xCC, 0xCC, 0x00}}, /* ň */
+    {0x014C, {0xFC, 0x00, 0x38, 0x6C, 0xC6, 0xC6, 0x6C, 0x38}}, /* Ō */
+    {0x014D, {0xFC, 0x00, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0x00}}, /* ō */
+    {0x0150, {0x36, 0x6C, 0x38, 0x6C, 0xC6, 0xC6, 0x6C, 0x38}}, /* Ő */
+    {0x0151, {0x36, 0x6C, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0x00}}, /* ő */
+    {0x0152, {0x7E, 0xD8, 0xD8, 0xDE, 0xD8, 0xD8, 0x7E, 0x00}}, /* Œ */
+    {0x0153, {0x00, 0x00, 0x6C, 0xDA, 0xDE, 0xD8, 0x6E, 0x00}}, /* œ */
+    {0x0154, {0x0C, 0x30, 0xFC, 0x66, 0x7C, 0x6C, 0x66, 0xE6}}, /* Ŕ */
+    {0x0155, {0x0C, 0x30, 0xDC, 0x76, 0x66, 0x60, 0xF0, 0x00}}, /* ŕ */
+    {0x0158, {0xCC, 0x30, 0xFC, 0x66, 0x7C, 0x6C, 0x66, 0xE6}}, /* Ř */
+    {0x0159, {0xCC, 0x30, 0xDC, 0x76, 0x66, 0x60, 0xF0, 0x00}}, /* ř */
+    {0x015A, {0x0C, 0x30, 0x78, 0xCC, 0x70, 0x1C, 0xCC, 0x78}}, /* Ś */
+    {0x015B, {0x0C, 0x30, 0x7C, 0xC0, 0x78, 0x0C, 0xF8, 0x00}}, /* ś */
+    {0x015E, {0x78, 0xCC, 0xE0, 0x70, 0x1C, 0xCC, 0x78, 0x30}}, /* Ş */
+    {0x015F, {0x00, 0x00, 0x7C, 0xC0, 0x78, 0x0C, 0xF8, 0x30}}, /* ş */
+    {0x0160, {0xCC, 0x30, 0x78, 0xCC, 0x70, 0x1C, 0xCC, 0x78}}, /* Š */
+    {0x0161, {0xCC, 0x30, 0x7C, 0xC0, 0x78, 0x0C, 0xF8, 0x00}}, /* š */
+    {0x0162, {0xFC, 0xB4, 0x30, 0x30, 0x30, 0x30, 0x78, 0x30}}, /* Ţ */
+    {0x0163, {0x10, 0x30, 0x7C, 0x30, 0x30, 0x34, 0x18, 0x30}}, /* ţ */
+    {0x016A, {0xFC, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC}}, /* Ū */
+    {0x016B, {0xFC, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x00}}, /* ū */
+    {0x016E, {0x78, 0x48, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC}}, /* Ů */
+    {0x016F, {0x78, 0x48, 0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x00}}, /* ů */
+    {0x0170, {0x36, 0x6C, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC}}, /* Ű */
+    {0x0171, {0x36, 0x6C, 0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x00}}, /* ű */
+    {0x0178, {0xCC, 0x00, 0xCC, 0xCC, 0x78, 0x30, 0x30, 0x78}}, /* Ÿ */
+    {0x0179, {0x0C, 0x30, 0xFE, 0xC6, 0x18, 0x32, 0x66, 0xFE}}, /* Ź */
+    {0x017A, {0x0C, 0x30, 0xFC, 0x98, 0x30, 0x64, 0xFC, 0x00}}, /* ź */
+    {0x017B, {0x30, 0x00, 0xFE, 0xC6, 0x18, 0x32, 0x66, 0xFE}}, /* Ż */
+    {0x017C, {0x30, 0x00, 0xFC, 0x98, 0x30, 0x64, 0xFC, 0x00}}, /* ż */
+    {0x017D, {0xCC, 0x30, 0xFE, 0xC6, 0x18, 0x32, 0x66, 0xFE}}, /* Ž */
+    {0x017E, {0xCC, 0x30, 0xFC, 0x98, 0x30, 0x64, 0xFC, 0x00}}, /* ž */
+    {0x2013, {0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00}}, /* en dash */
+    {0x2014, {0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00}}, /* em dash */
+    {0x2018, {0x18, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* ‘ */
+    {0x2019, {0x60, 0x60, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* ’ */
+    {0x201C, {0x6C, 0xD8, 0xD8, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* “ */
+    {0x201D, {0x6C, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* ” */
+    {0x2022, {0x00, 0x00, 0x30, 0x78, 0x78, 0x30, 0x00, 0x00}}, /* • */
+    {0x2026, {0x00, 0x00, 0x00, 0x00, 0x00, 0xDB, 0xDB, 0x00}}, /* … */
+    {0x20AC, {0x3C, 0x66, 0xF8, 0x60, 0xF8, 0x66, 0x3C, 0x00}}, /* € */
+    {0x2190, {0x00, 0x30, 0x60, 0xFE, 0x60, 0x30, 0x00, 0x00}}, /* ← */
+    {0x2191, {0x30, 0x78, 0xFC, 0x30, 0x30, 0x30, 0x30, 0x00}}, /* ↑ */
+    {0x2192, {0x00, 0x0C, 0x06, 0xFE, 0x06, 0x0C, 0x00, 0x00}}, /* → */
+    {0x2193, {0x30, 0x30, 0x30, 0x30, 0xFC, 0x78, 0x30, 0x00}}, /* ↓ */
+    {0x2500, {0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00}}, /* ─ */
+    {0x2501, {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00}}, /* ━ */
+    {0x2502, {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18}}, /* │ */
+    {0x2503, {0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C}}, /* ┃ */
+    {0x2504, {0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00}}, /* ┄ */
+    {0x2505, {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00}}, /* ┅ */
+    {0x2506, {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18}}, /* ┆ */
+    {0x2507, {0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C}}, /* ┇ */
+    {0x2508, {0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00}}, /* ┈ */
+    {0x2509, {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00}}, /* ┉ */
+    {0x250A, {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18}}, /* ┊ */
+    {0x250B, {0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C}}, /* ┋ */
+    {0x250C, {0x00, 0x00, 0x00, 0x1F, 0x1F, 0x18, 0x18, 0x18}}, /* ┌ */
+    {0x250D, {0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x18, 0x18}}, /* ┍ */
+    {0x250E, {0x00, 0x00, 0x00, 0x3F, 0x3F, 0x3C, 0x3C, 0x3C}}, /* ┎ */
+    {0x250F, {0x00, 0x00, 0x3F, 0x3F, 0x3F, 0x3F, 0x3C, 0x3C}}, /* ┏ */
+    {0x2510, {0x00, 0x00, 0x00, 0xF8, 0xF8, 0x18, 0x18, 0x18}}, /* ┐ */
+    {0x2511, {0x00, 0x00, 0xF8, 0xF8, 0xF8, 0xF8, 0x18, 0x18}}, /* ┑ */
+    {0x2512, {0x00, 0x00, 0x00, 0xFC, 0xFC, 0x3C, 0x3C, 0x3C}}, /* ┒ */
+    {0x2513, {0x00, 0x00, 0xFC, 0xFC, 0xFC, 0xFC, 0x3C, 0x3C}}, /* ┓ */
+    {0x2514, {0x18, 0x18, 0x18, 0x1F, 0x1F, 0x00, 0x00, 0x00}}, /* └ */
+    {0x2515, {0x18, 0x18, 0x1F, 0x1F, 0x1F, 0x1F, 0x00, 0x00}}, /* ┕ */
+    {0x2516, {0x3C, 0x3C, 0x3C, 0x3F, 0x3F, 0x00, 0x00, 0x00}}, /* ┖ */
+    {0x2517, {0x3C, 0x3C, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00}}, /* ┗ */
+    {0x2518, {0x18, 0x18, 0x18, 0xF8, 0xF8, 0x00, 0x00, 0x00}}, /* ┘ */
+    {0x2519, {0x18, 0x18, 0xF8, 0xF8, 0xF8, 0xF8, 0x00, 0x00}}, /* ┙ */
+    {0x251A, {0x3C, 0x3C, 0x3C, 0xFC, 0xFC, 0x00, 0x00, 0x00}}, /* ┚ */
+    {0x251B, {0x3C, 0x3C, 0xFC, 0xFC, 0xFC, 0xFC, 0x00, 0x00}}, /* ┛ */
+    {0x251C, {0x18, 0x18, 0x18, 0x1F, 0x1F, 0x18, 0x18, 0x18}}, /* ├ */
+    {0x251D, {0x18, 0x18, 0x1F, 0x1F, 0x1F, 0x1F, 0x18, 0x18}}, /* ┝ */
+    {0x251E, {0x3C, 0x3C, 0x3C, 0x3F, 0x3F, 0x18, 0x18, 0x18}}, /* ┞ */
+    {0x251F, {0x18, 0x18, 0x18, 0x3F, 0x3F, 0x3C, 0x3C, 0x3C}}, /* ┟ */
+    {0x2520, {0x3C, 0x3C, 0x3C, 0x3F, 0x3F, 0x3C, 0x3C, 0x3C}}, /* ┠ */
+    {0x2521, {0x3C, 0x3C, 0x3F, 0x3F, 0x3F, 0x3F, 0x18, 0x18}}, /* ┡ */
+    {0x2522, {0x18, 0x18, 0x3F, 0x3F, 0x3F, 0x3F, 0x3C, 0x3C}}, /* ┢ */
+    {0x2523, {0x3C, 0x3C, 0x3F, 0x3F, 0x3F, 0x3F, 0x3C, 0x3C}}, /* ┣ */
+    {0x2524, {0x18, 0x18, 0x18, 0xF8, 0xF8, 0x18, 0x18, 0x18}}, /* ┤ */
+    {0x2525, {0x18, 0x18, 0xF8, 0xF8, 0xF8, 0xF8, 0x18, 0x18}}, /* ┥ */
+    {0x2526, {0x3C, 0x3C, 0x3C, 0xFC, 0xFC, 0x18, 0x18, 0x18}}, /* ┦ */
+    {0x2527, {0x18, 0x18, 0x18, 0xFC, 0xFC, 0x3C, 0x3C, 0x3C}}, /* ┧ */
+    {0x2528, {0x3C, 0x3C, 0x3C, 0xFC, 0xFC, 0x3C, 0x3C, 0x3C}}, /* ┨ */
+    {0x2529, {0x3C, 0x3C, 0xFC, 0xFC, 0xFC, 0xFC, 0x18, 0x18}}, /* ┩ */
+    {0x252A, {0x18, 0x18, 0xFC, 0xFC, 0xFC, 0xFC, 0x3C, 0x3C}}, /* ┪ */
+    {0x252B, {0x3C, 0x3C, 0xFC, 0xFC, 0xFC, 0xFC, 0x3C, 0x3C}}, /* ┫ */
+    {0x252C, {0x00, 0x00, 0x00, 0xFF, 0xFF, 0x18, 0x18, 0x18}}, /* ┬ */
+    {0x252D, {0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xF8, 0x18, 0x18}}, /* ┭ */
+    {0x252E, {0x00, 0x00, 0x1F, 0xFF, 0xFF, 0x1F, 0x18, 0x18}}, /* ┮ */
+    {0x252F, {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x18, 0x18}}, /* ┯ */
+    {0x2530, {0x00, 0x00, 0x00, 0xFF, 0xFF, 0x3C, 0x3C, 0x3C}}, /* ┰ */
+    {0x2531, {0x00, 0x00, 0xFC, 0xFF, 0xFF, 0xFC, 0x3C, 0x3C}}, /* ┱ */
+    {0x2532, {0x00, 0x00, 0x3F, 0xFF, 0xFF, 0x3F, 0x3C, 0x3C}}, /* ┲ */
+    {0x2533, {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x3C, 0x3C}}, /* ┳ */
+    {0x2534, {0x18, 0x18, 0x18, 0xFF, 0xFF, 0x00, 0x00, 0x00}}, /* ┴ */
+    {0x2535, {0x18, 0x18, 0xF8, 0xFF, 0xFF, 0xF8, 0x00, 0x00}}, /* ┵ */
+    {0x2536, {0x18, 0x18, 0x1F, 0xFF, 0xFF, 0x1F, 0x00, 0x00}}, /* ┶ */
+    {0x2537, {0x18, 0x18, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00}}, /* ┷ */
+    {0x2538, {0x3C, 0x3C, 0x3C, 0xFF, 0xFF, 0x00, 0x00, 0x00}}, /* ┸ */
+    {0x2539, {0x3C, 0x3C, 0xFC, 0xFF, 0xFF, 0xFC, 0x00, 0x00}}, /* ┹ */
+    {0x253A, {0x3C, 0x3C, 0x3F, 0xFF, 0xFF, 0x3F, 0x00, 0x00}}, /* ┺ */
+    {0x253B, {0x3C, 0x3C, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00}}, /* ┻ */
+    {0x253C, {0x18, 0x18, 0x18, 0xFF, 0xFF, 0x18, 0x18, 0x18}}, /* ┼ */
+    {0x253D, {0x18, 0x18, 0xF8, 0xFF, 0xFF, 0xF8, 0x18, 0x18}}, /* ┽ */
+    {0x253E, {0x18, 0x18, 0x1F, 0xFF, 0xFF, 0x1F, 0x18, 0x18}}, /* ┾ */
+    {0x253F, {0x18, 0x18, 0xFF, 0xFF, 0xFF, 0xFF, 0x18, 0x18}}, /* ┿ */
+    {0x2540, {0x3C, 0x3C, 0x3C, 0xFF, 0xFF, 0x18, 0x18, 0x18}}, /* ╀ */
+    {0x2541, {0x18, 0x18, 0x18, 0xFF, 0xFF, 0x3C, 0x3C, 0x3C}}, /* ╁ */
+    {0x2542, {0x3C, 0x3C, 0x3C, 0xFF, 0xFF, 0x3C, 0x3C, 0x3C}}, /* ╂ */
+    {0x2543, {0x3C, 0x3C, 0xFC, 0xFF, 0xFF, 0xFC, 0x18, 0x18}}, /* ╃ */
+    {0x2544, {0x3C, 0x3C, 0x3F, 0xFF, 0xFF, 0x3F, 0x18, 0x18}}, /* ╄ */
+    {0x2545, {0x18, 0x18, 0xFC, 0xFF, 0xFF, 0xFC, 0x3C, 0x3C}}, /* ╅ */
+    {0x2546, {0x18, 0x18, 0x3F, 0xFF, 0xFF, 0x3F, 0x3C, 0x3C}}, /* ╆ */
+    {0x2547, {0x3C, 0x3C, 0xFF, 0xFF, 0xFF, 0xFF, 0x18, 0x18}}, /* ╇ */
+    {0x2548, {0x18, 0x18, 0xFF, 0xFF, 0xFF, 0xFF, 0x3C, 0x3C}}, /* ╈ */
+    {0x2549, {0x3C, 0x3C, 0xFC, 0xFF, 0xFF, 0xFC, 0x3C, 0x3C}}, /* ╉ */
+    {0x254A, {0x3C, 0x3C, 0x3F, 0xFF, 0xFF, 0x3F, 0x3C, 0x3C}}, /* ╊ */
+    {0x254B, {0x3C, 0x3C, 0xFF, 0xFF, 0xFF, 0xFF, 0x3C, 0x3C}}, /* ╋ */
+    {0x254C, {0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00}}, /* ╌ */
+    {0x254D, {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00}}, /* ╍ */
+    {0x254E, {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18}}, /* ╎ */
+    {0x254F, {0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C}}, /* ╏ */
+    {0x2550, {0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00}}, /* ═ */
+    {0x2551, {0x24, 0x24, 0x24, 0x24, 0x24, 0x24, 0x24, 0x24}}, /* ║ */
+    {0x2552, {0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x18, 0x18}}, /* ╒ */
+    {0x2553, {0x00, 0x00, 0x00, 0x27, 0x27, 0x24, 0x24, 0x24}}, /* ╓ */
+    {0x2554, {0x00, 0x00, 0x3F, 0x20, 0x20, 0x27, 0x24, 0x24}}, /* ╔ */
+    {0x2555, {0x00, 0x00, 0xF8, 0x00, 0x00, 0xF8, 0x18, 0x18}}, /* ╕ */
+    {0x2556, {0x00, 0x00, 0x00, 0xE4, 0xE4, 0x24, 0x24, 0x24}}, /* ╖ */
+    {0x2557, {0x00, 0x00, 0xFC, 0x04, 0x04, 0xE4, 0x24, 0x24}}, /* ╗ */
+    {0x2558, {0x18, 0x18, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00}}, /* ╘ */
+    {0x2559, {0x24, 0x24, 0x24, 0x27, 0x27, 0x00, 0x00, 0x00}}, /* ╙ */
+    {0x255A, {0x24, 0x24, 0x27, 0x20, 0x20, 0x3F, 0x00, 0x00}}, /* ╚ */
+    {0x255B, {0x18, 0x18, 0xF8, 0x00, 0x00, 0xF8, 0x00, 0x00}}, /* ╛ */
+    {0x255C, {0x24, 0x24, 0x24, 0xE4, 0xE4, 0x00, 0x00, 0x00}}, /* ╜ */
+    {0x255D, {0x24, 0x24, 0xE4, 0x04, 0x04, 0xFC, 0x00, 0x00}}, /* ╝ */
+    {0x255E, {0x18, 0x18, 0x1F, 0x00, 0x00, 0x1F, 0x18, 0x18}}, /* ╞ */
+    {0x255F, {0x24, 0x24, 0x24, 0x27, 0x27, 0x24, 0x24, 0x24}}, /* ╟ */
+    {0x2560, {0x24, 0x24, 0x27, 0x20, 0x20, 0x27, 0x24, 0x24}}, /* ╠ */
+    {0x2561, {0x18, 0x18, 0xF8, 0x00, 0x00, 0xF8, 0x18, 0x18}}, /* ╡ */
+    {0x2562, {0x24, 0x24, 0x24, 0xE4, 0xE4, 0x24, 0x24, 0x24}}, /* ╢ */
+    {0x2563, {0x24, 0x24, 0xE4, 0x04, 0x04, 0xE4, 0x24, 0x24}}, /* ╣ */
+    {0x2564, {0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x18, 0x18}}, /* ╤ */
+    {0x2565, {0x00, 0x00, 0x00, 0xE7, 0xE7, 0x24, 0x24, 0x24}}, /* ╥ */
+    {0x2566, {0x00, 0x00, 0xFF, 0x00, 0x00, 0xE7, 0x24, 0x24}}, /* ╦ */
+    {0x2567, {0x18, 0x18, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00}}, /* ╧ */
+    {0x2568, {0x24, 0x24, 0x24, 0xE7, 0xE7, 0x00, 0x00, 0x00}}, /* ╨ */
+    {0x2569, {0x24, 0x24, 0xE7, 0x00, 0x00, 0xFF, 0x00, 0x00}}, /* ╩ */
+    {0x256A, {0x18, 0x18, 0xFF, 0x00, 0x00, 0xFF, 0x18, 0x18}}, /* ╪ */
+    {0x256B, {0x24, 0x24, 0x24, 0xE7, 0xE7, 0x24, 0x24, 0x24}}, /* ╫ */
+    {0x256C, {0x24, 0x24, 0xE7, 0x00, 0x00, 0xE7, 0x24, 0x24}}, /* ╬ */
+    {0x256D, {0x00, 0x00, 0x00, 0x1F, 0x1F, 0x18, 0x18, 0x18}}, /* ╭ */
+    {0x256E, {0x00, 0x00, 0x00, 0xF8, 0xF8, 0x18, 0x18, 0x18}}, /* ╮ */
+    {0x256F, {0x18, 0x18, 0x18, 0xF8, 0xF8, 0x00, 0x00, 0x00}}, /* ╯ */
+    {0x2570, {0x18, 0x18, 0x18, 0x1F, 0x1F, 0x00, 0x00, 0x00}}, /* ╰ */
+    {0x2571, {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80}}, /* ╱ */
+    {0x2572, {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01}}, /* ╲ */
+    {0x2573, {0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81}}, /* ╳ */
+    {0x2574, {0x00, 0x00, 0x00, 0xF8, 0xF8, 0x00, 0x00, 0x00}}, /* ╴ */
+    {0x2575, {0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00}}, /* ╵ */
+    {0x2576, {0x00, 0x00, 0x00, 0x1F, 0x1F, 0x00, 0x00, 0x00}}, /* ╶ */
+    {0x2577, {0x00, 0x00, 0x00, 0x18, 0x18, 0x18, 0x18, 0x18}}, /* ╷ */
+    {0x2578, {0x00, 0x00, 0xFC, 0xFC, 0xFC, 0xFC, 0x00, 0x00}}, /* ╸ */
+    {0x2579, {0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00}}, /* ╹ */
+    {0x257A, {0x00, 0x00, 0x3F, 0x3F, 0x3F, 0x3F, 0x00, 0x00}}, /* ╺ */
+    {0x257B, {0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C}}, /* ╻ */
+    {0x257C, {0x00, 0x00, 0x3F, 0xFF, 0xFF, 0x3F, 0x00, 0x00}}, /* ╼ */
+    {0x257D, {0x18, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C}}, /* ╽ */
+    {0x257E, {0x00, 0x00, 0xFC, 0xFF, 0xFF, 0xFC, 0x00, 0x00}}, /* ╾ */
+    {0x257F, {0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0x18}}, /* ╿ */
+    {0x2580, {0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00}}, /* ▀ */
+    {0x2581, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF}}, /* ▁ */
+    {0x2582, {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF}}, /* ▂ */
+    {0x2583, {0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF}}, /* ▃ */
+    {0x2584, {0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF}}, /* ▄ */
+    {0x2585, {0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}}, /* ▅ */
+    {0x2586, {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}}, /* ▆ */
+    {0x2587, {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}}, /* ▇ */
+    {0x2588, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}}, /* █ */
+    {0x2589, {0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE}}, /* ▉ */
+    {0x258A, {0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC}}, /* ▊ */
+    {0x258B, {0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8}}, /* ▋ */
+    {0x258C, {0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0}}, /* ▌ */
+    {0x258D, {0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0}}, /* ▍ */
+    {0x258E, {0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0}}, /* ▎ */
+    {0x258F, {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80}}, /* ▏ */
+    {0x2590, {0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F}}, /* ▐ */
+    {0x2591, {0x88, 0x22, 0x88, 0x22, 0x88, 0x22, 0x88, 0x22}}, /* ░ */
+    {0x2592, {0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55}}, /* ▒ */
+    {0x2593, {0x77, 0xDD, 0x77, 0xDD, 0x77, 0xDD, 0x77, 0xDD}}, /* ▓ */
+    {0x2594, {0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}}, /* ▔ */
+    {0x2595, {0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01}}, /* ▕ */
+    {0x2596, {0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0, 0xF0}}, /* ▖ */
+    {0x2597, {0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x0F}}, /* ▗ */
+    {0x2598, {0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00}}, /* ▘ */
+    {0x2599, {0xF0, 0xF0, 0xF0, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF}}, /* ▙ */
+    {0x259A, {0xF0, 0xF0, 0xF0, 0xF0, 0x0F, 0x0F, 0x0F, 0x0F}}, /* ▚ */
+    {0x259B, {0xFF, 0xFF, 0xFF, 0xFF, 0xF0, 0xF0, 0xF0, 0xF0}}, /* ▛ */
+    {0x259C, {0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0x0F, 0x0F, 0x0F}}, /* ▜ */
+    {0x259D, {0x0F, 0x0F, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00}}, /* ▝ */
+    {0x259E, {0x0F, 0x0F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0}}, /* ▞ */
+    {0x259F, {0x0F, 0x0F, 0x0F, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF}}, /* ▟ */
+    {0x25A0, {0x00, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x7E, 0x00}}, /* ■ */
+    {0x25A1, {0x00, 0x7E, 0x42, 0x42, 0x42, 0x42, 0x7E, 0x00}}, /* □ */
+    {0x25B2, {0x00, 0x18, 0x3C, 0x7E, 0xFF, 0x00, 0x00, 0x00}}, /* ▲ */
+    {0x25B6, {0x80, 0xE0, 0xF8, 0xFE, 0xF8, 0xE0, 0x80, 0x00}}, /* ▶ */
+    {0x25BC, {0x00, 0xFF, 0x7E, 0x3C, 0x18, 0x00, 0x00, 0x00}}, /* ▼ */
+    {0x25C0, {0x01, 0x07, 0x1F, 0x7F, 0x1F, 0x07, 0x01, 0x00}}, /* ◀ */
+    {0x25CB, {0x3C, 0x66, 0xC3, 0xC3, 0xC3, 0x66, 0x3C, 0x00}}, /* ○ */
+    {0x25CF, {0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C, 0x00}}, /* ● */
+    {0x2713, {0x00, 0x01, 0x02, 0x04, 0x88, 0x50, 0x20, 0x00}}, /* ✓ */
+    {0x2717, {0x00, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x00}}, /* ✗ */
+    {0xFFFD, {0x86, 0x32, 0xF2, 0xE6, 0xCE, 0xFE, 0xCE, 0x00}}, /* replacement character */
+};
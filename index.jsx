@@ -37,6 +37,31 @@ const Tree = () => {
   );
 };
 
+const TABLE_ROWS = 1000;
+const tableData = [
+  Array.from({ length: TABLE_ROWS }, (_, i) => i),
+  Array.from({ length: TABLE_ROWS }, (_, i) => `item ${(i * 7919) % TABLE_ROWS}`),
+  Array.from({ length: TABLE_ROWS }, (_, i) => ((i * 31) % 1000) / 10),
+];
+
+const LogTail = () => {
+  const logRef = React.useRef(null);
+
+  React.useEffect(() => {
+    let n = 0;
+    const timer = setInterval(() => {
+      logRef.current?.append(`[${new Date().toISOString()}] tick ${n++}`);
+    }, 100);
+    return () => clearInterval(timer);
+  }, []);
+
+  return (
+    <row height={80} widths={[-1]}>
+      <log ref={logRef} capacity={1000} />
+    </row>
+  );
+};
+
 const Modal2 = ({ onClose }) => {
   const [url, setUrl] = React.useState(
     'https://jsonplaceholder.typicode.com/todos/1'
@@ -101,13 +126,12 @@ const Modal = ({ onClose }) => {
       onClose={onClose}
     >
       <row height={-25} widths={[-1]}>
-        <panel title="Modal Panel">
-          <row height={0} widths={[-1]}>
-            {log.map((val, i) => (
-              <text key={i}>{val}</text>
-            ))}
-          </row>
-        </panel>
+        <list
+          title="Modal Panel"
+          itemCount={log.length}
+          itemHeight={8}
+          renderItem={(i) => <text>{log[i]}</text>}
+        />
       </row>
       <row height={20} widths={[150, -1]}>
         <input value={msg} onChange={setMsg} onSubmit={onSubmit} />
@@ -177,6 +201,14 @@ const App = () => {
         </col>
       </row>
       <Tree />
+      <header title="Log tail">
+        <LogTail />
+      </header>
+      <header title="Table">
+        <row height={120} widths={[-1]}>
+          <table columns={['#', 'Name', 'Score']} data={tableData} />
+        </row>
+      </header>
     </>
   );
 };
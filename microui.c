@@ -35,10 +35,11 @@
     }                                                                \
   } while (0)
 
-#define push(stk, val) do {                                                 \
-    expect((stk).idx < (int) (sizeof((stk).items) / sizeof(*(stk).items))); \
-    (stk).items[(stk).idx] = (val);                                         \
-    (stk).idx++; /* incremented after incase `val` uses this value */       \
+#define push(stk, val) do {                                           \
+    if ((stk).idx >= (stk).cap) { overflow(#stk, (stk).cap); }       \
+    (stk).items[(stk).idx] = (val);                                   \
+    (stk).idx++; /* incremented after incase `val` uses this value */ \
+    if ((stk).idx > (stk).peak) { (stk).peak = (stk).idx; }           \
   } while (0)
 
 #define pop(stk) do {      \
@@ -47,6 +48,13 @@
   } while (0)
 
 
+static void overflow(const char *what, int cap) {
+  fprintf(stderr, "Fatal error: microui %s overflow (capacity %d), "
+    "raise its size in mu_Config\n", what, cap);
+  abort();
+}
+
+
 static mu_Rect unclipped_rect = { 0, 0, 0x1000000, 0x1000000 };
 
 static mu_Style default_style = {
@@ -115,6 +123,16 @@ static int rect_overlaps_vec2(mu_Rect r, mu_Vec2 p) {
 }
 
 
+/* grows a malloc'd buffer of `size` sized items to hold at least `count` */
+static void* buffer_reserve(void *buf, int *cap, int count, int size) {
+  if (count <= *cap) { return buf; }
+  while (*cap < count) { *cap = *cap ? *cap * 2 : 64; }
+  buf = realloc(buf, (size_t) *cap * size);
+  expect(buf != NULL);
+  return buf;
+}
+
+
 static void draw_frame(mu_Context *ctx, mu_Rect rect, int colorid) {
   mu_draw_rect(ctx, rect, ctx->style->colors[colorid]);
   if (colorid == MU_COLOR_SCROLLBASE  ||
@@ -127,17 +145,141 @@ static void draw_frame(mu_Context *ctx, mu_Rect rect, int colorid) {
 }
 
 
+static void pool_init_items(mu_Pool *pool);
+static void cache_record_treenode(mu_Context *ctx, mu_Id id);
+
+
 void mu_init(mu_Context *ctx) {
+  mu_init_ex(ctx, NULL);
+}
+
+
+/* all stacks and pools live in one arena allocation. this is called once to
+** measure it (while `ctx->arena` is NULL) and once to hand out the slices */
+static void* arena_slice(mu_Context *ctx, size_t *offset, size_t size) {
+  void *res = ctx->arena ? (char*) ctx->arena + *offset : NULL;
+  *offset += (size + 15) & ~(size_t) 15;
+  return res;
+}
+
+#define arena_stack(ctx, offset, stk, n) do {                                 \
+    (stk).cap = (n);                                                          \
+    (stk).items = arena_slice(ctx, offset, (n) * sizeof(*(stk).items));       \
+  } while (0)
+
+static void arena_pool(mu_Context *ctx, size_t *offset, mu_Pool *pool, int len) {
+  int size = 16;
+  while (size < len * 2) { size <<= 1; }
+  pool->len = len;
+  pool->index_mask = size - 1;
+  pool->items = arena_slice(ctx, offset, len * sizeof(mu_PoolItem));
+  pool->index = arena_slice(ctx, offset, size * sizeof(int));
+}
+
+static size_t carve_arena(mu_Context *ctx) {
+  mu_Config *cfg = &ctx->config;
+  size_t offset = 0;
+  int *widths, i;
+  arena_stack(ctx, &offset, ctx->root_list, cfg->root_list_size);
+  arena_stack(ctx, &offset, ctx->root_order, cfg->root_list_size);
+  arena_stack(ctx, &offset, ctx->container_stack, cfg->container_stack_size);
+  arena_stack(ctx, &offset, ctx->clip_stack, cfg->clip_stack_size);
+  arena_stack(ctx, &offset, ctx->id_stack, cfg->id_stack_size);
+  arena_stack(ctx, &offset, ctx->layout_stack, cfg->layout_stack_size);
+  ctx->layout_widths = arena_slice(ctx, &offset,
+    cfg->layout_stack_size * cfg->max_widths * sizeof(int));
+  ctx->containers = arena_slice(ctx, &offset,
+    cfg->container_pool_size * sizeof(mu_Container));
+  arena_pool(ctx, &offset, &ctx->container_pool, cfg->container_pool_size);
+  arena_pool(ctx, &offset, &ctx->treenode_pool, cfg->treenode_pool_size);
+  arena_pool(ctx, &offset, &ctx->layout_cache_pool, cfg->layout_cache_size);
+  ctx->layout_caches = arena_slice(ctx, &offset,
+    cfg->layout_cache_size * sizeof(mu_LayoutCache));
+  /* each cache entry saves the row widths of its start and end layouts */
+  widths = arena_slice(ctx, &offset,
+    cfg->layout_cache_size * 2 * cfg->max_widths * sizeof(int));
+  for (i = 0; widths && i < cfg->layout_cache_size; i++) {
+    ctx->layout_caches[i].widths = widths + i * 2 * cfg->max_widths;
+  }
+  arena_pool(ctx, &offset, &ctx->text_cache_pool, cfg->text_cache_size);
+  /* one more entry than the pool holds, used when the pool is exhausted */
+  ctx->text_caches = arena_slice(ctx, &offset,
+    (cfg->text_cache_size + 1) * sizeof(mu_TextCache));
+  return offset;
+}
+
+
+void mu_init_ex(mu_Context *ctx, const mu_Config *config) {
+  static const mu_Config none;
   memset(ctx, 0, sizeof(*ctx));
   ctx->draw_frame = draw_frame;
   ctx->_style = default_style;
   ctx->style = &ctx->_style;
+  /* zero fields in `config` keep their default */
+  ctx->config = config ? *config : none;
+#define config_default(field, value) do {                   \
+    if (ctx->config.field <= 0) { ctx->config.field = value; } \
+  } while (0)
+  config_default(root_list_size, MU_ROOTLIST_SIZE);
+  config_default(container_stack_size, MU_CONTAINERSTACK_SIZE);
+  config_default(clip_stack_size, MU_CLIPSTACK_SIZE);
+  config_default(id_stack_size, MU_IDSTACK_SIZE);
+  config_default(layout_stack_size, MU_LAYOUTSTACK_SIZE);
+  config_default(max_widths, MU_MAX_WIDTHS);
+  config_default(container_pool_size, MU_CONTAINERPOOL_SIZE);
+  config_default(treenode_pool_size, MU_TREENODEPOOL_SIZE);
+  config_default(layout_cache_size, MU_LAYOUTCACHE_SIZE);
+  config_default(text_cache_size, MU_TEXTCACHE_SIZE);
+#undef config_default
+  ctx->arena = calloc(1, carve_arena(ctx));
+  expect(ctx->arena != NULL);
+  carve_arena(ctx);
+  pool_init_items(&ctx->container_pool);
+  pool_init_items(&ctx->treenode_pool);
+  pool_init_items(&ctx->layout_cache_pool);
+  pool_init_items(&ctx->text_cache_pool);
+  ctx->input_text = buffer_reserve(NULL, &ctx->input_text_cap, 1, 1);
+  ctx->input_text[0] = '\0';
+}
+
+
+void mu_free(mu_Context *ctx) {
+  mu_CommandChunk *chunk = ctx->command_list.head;
+  int i;
+  while (chunk) {
+    mu_CommandChunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  memset(&ctx->command_list, 0, sizeof(ctx->command_list));
+  free(ctx->hit_grid.entries);
+  free(ctx->hit_grid.cells);
+  memset(&ctx->hit_grid, 0, sizeof(ctx->hit_grid));
+  for (i = 0; ctx->arena && i < ctx->config.layout_cache_size; i++) {
+    free(ctx->layout_caches[i].commands);
+    free(ctx->layout_caches[i].controls);
+    free(ctx->layout_caches[i].control_rects);
+    free(ctx->layout_caches[i].treenodes);
+  }
+  for (i = 0; ctx->arena && i <= ctx->config.text_cache_size; i++) {
+    free(ctx->text_caches[i].text);
+    free(ctx->text_caches[i].lines);
+  }
+  free(ctx->arena);
+  ctx->arena = NULL;
+  free(ctx->input_text);
+  ctx->input_text = NULL;
+  ctx->input_text_cap = 0;
 }
 
 
 void mu_begin(mu_Context *ctx) {
   expect(ctx->text_width && ctx->text_height);
+  ctx->command_list.chunk = ctx->command_list.head;
   ctx->command_list.idx = 0;
+  ctx->command_list.used = 0;
+  ctx->hit_grid.count = 0;
+  ctx->hit_grid.built = 0;
   ctx->root_list.idx = 0;
   ctx->scroll_target = NULL;
   ctx->hover_root = ctx->next_hover_root;
@@ -148,8 +290,46 @@ void mu_begin(mu_Context *ctx) {
 }
 
 
-static int compare_zindex(const void *a, const void *b) {
-  return (*(mu_Container**) a)->zindex - (*(mu_Container**) b)->zindex;
+static char* command_list_end(mu_Context *ctx) {
+  return ctx->command_list.chunk->items + ctx->command_list.idx;
+}
+
+
+/* `root_order` keeps the root containers sorted by zindex across frames. the
+** roots that were not begun this frame are dropped, new ones are appended and
+** the list is only re-sorted if that changed it or a zindex was changed. as
+** the order is almost always the same as last frame's an insertion sort is
+** used, which is also stable for equal zindexes */
+static void update_root_order(mu_Context *ctx) {
+  mu_Container **order = ctx->root_order.items;
+  int i, j, n = 0, changed = ctx->zindex_changed;
+  for (i = 0; i < ctx->root_order.idx; i++) {
+    mu_Container *cnt = order[i];
+    if (cnt->root_frame == ctx->frame) {
+      order[n++] = cnt;
+      cnt->root_frame = -1;
+    } else {
+      changed = 1;
+    }
+  }
+  for (i = 0; i < ctx->root_list.idx; i++) {
+    mu_Container *cnt = ctx->root_list.items[i];
+    if (cnt->root_frame == ctx->frame) {
+      order[n++] = cnt;
+      cnt->root_frame = -1;
+      changed = 1;
+    }
+  }
+  ctx->root_order.idx = n;
+  ctx->zindex_changed = 0;
+  if (!changed) { return; }
+  for (i = 1; i < n; i++) {
+    mu_Container *cnt = order[i];
+    for (j = i; j > 0 && order[j - 1]->zindex > cnt->zindex; j--) {
+      order[j] = order[j - 1];
+    }
+    order[j] = cnt;
+  }
 }
 
 
@@ -187,24 +367,24 @@ void mu_end(mu_Context *ctx) {
   ctx->last_mouse_pos = ctx->mouse_pos;
 
   /* sort root containers by zindex */
-  n = ctx->root_list.idx;
-  qsort(ctx->root_list.items, n, sizeof(mu_Container*), compare_zindex);
+  update_root_order(ctx);
+  n = ctx->root_order.idx;
 
   /* set root container jump commands */
   for (i = 0; i < n; i++) {
-    mu_Container *cnt = ctx->root_list.items[i];
+    mu_Container *cnt = ctx->root_order.items[i];
     /* if this is the first container then make the first command jump to it.
     ** otherwise set the previous container's tail to jump to this one */
     if (i == 0) {
-      mu_Command *cmd = (mu_Command*) ctx->command_list.items;
+      mu_Command *cmd = (mu_Command*) ctx->command_list.head->items;
       cmd->jump.dst = (char*) cnt->head + sizeof(mu_JumpCommand);
     } else {
-      mu_Container *prev = ctx->root_list.items[i - 1];
+      mu_Container *prev = ctx->root_order.items[i - 1];
       prev->tail->jump.dst = (char*) cnt->head + sizeof(mu_JumpCommand);
     }
     /* make the last container's tail jump to the end of command list */
     if (i == n - 1) {
-      cnt->tail->jump.dst = ctx->command_list.items + ctx->command_list.idx;
+      cnt->tail->jump.dst = command_list_end(ctx);
     }
   }
 }
@@ -216,26 +396,70 @@ void mu_set_focus(mu_Context *ctx, mu_Id id) {
 }
 
 
-/* 32bit fnv-1a hash */
+/* 32bit murmur3 style hash, reading the data 4 bytes at a time */
 #define HASH_INITIAL 2166136261
 
+static mu_Id hash_mix(mu_Id h, mu_Id k) {
+  k *= 0xcc9e2d51;
+  k = (k << 15) | (k >> 17);
+  k *= 0x1b873593;
+  h ^= k;
+  h = (h << 13) | (h >> 19);
+  return h * 5 + 0xe6546b64;
+}
+
 static void hash(mu_Id *hash, const void *data, int size) {
   const unsigned char *p = data;
-  while (size--) {
-    *hash = (*hash ^ *p++) * 16777619;
+  mu_Id h = *hash, k;
+  int n;
+  for (n = size; n >= 4; n -= 4, p += 4) {
+    memcpy(&k, p, 4);
+    h = hash_mix(h, k);
+  }
+  if (n > 0) {
+    k = 0;
+    switch (n) {
+      case 3: k |= (mu_Id) p[2] << 16; /* fallthrough */
+      case 2: k |= (mu_Id) p[1] << 8;  /* fallthrough */
+      case 1: k |= p[0];
+    }
+    h = hash_mix(h, k);
   }
+  h ^= size;
+  h ^= h >> 16; h *= 0x85ebca6b;
+  h ^= h >> 13; h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  *hash = h;
+}
+
+
+mu_Id mu_hash(const void *data, int size) {
+  mu_Id res = HASH_INITIAL;
+  hash(&res, data, size);
+  return res;
 }
 
 
+/* an id is the hash of its data combined with the id on top of the id stack.
+** callers which already know the hash of the data, e.g. of a label that does
+** not change, can pass it with mu_set_next_hash() to skip hashing it */
 mu_Id mu_get_id(mu_Context *ctx, const void *data, int size) {
   int idx = ctx->id_stack.idx;
   mu_Id res = (idx > 0) ? ctx->id_stack.items[idx - 1] : HASH_INITIAL;
-  hash(&res, data, size);
+  mu_Id h = ctx->has_next_hash ? ctx->next_hash : mu_hash(data, size);
+  ctx->has_next_hash = 0;
+  hash(&res, &h, sizeof(h));
   ctx->last_id = res;
   return res;
 }
 
 
+void mu_set_next_hash(mu_Context *ctx, mu_Id hash) {
+  ctx->next_hash = hash;
+  ctx->has_next_hash = 1;
+}
+
+
 void mu_push_id(mu_Context *ctx, const void *data, int size) {
   push(ctx->id_stack, mu_get_id(ctx, data, size));
 }
@@ -279,6 +503,7 @@ static void push_layout(mu_Context *ctx, mu_Rect body, mu_Vec2 scroll) {
   memset(&layout, 0, sizeof(layout));
   layout.body = mu_rect(body.x - scroll.x, body.y - scroll.y, body.w, body.h);
   layout.max = mu_vec2(-0x1000000, -0x1000000);
+  layout.widths = ctx->layout_widths + ctx->layout_stack.idx * ctx->config.max_widths;
   push(ctx->layout_stack, layout);
   mu_layout_row(ctx, 1, &width, 0);
 }
@@ -309,17 +534,19 @@ mu_Container* mu_get_current_container(mu_Context *ctx) {
 
 static mu_Container* get_container(mu_Context *ctx, mu_Id id, int opt) {
   mu_Container *cnt;
+  /* containers can't be replayed from a cached region */
+  if (ctx->cache_recording) { ctx->cache_recording->valid = 0; }
   /* try to get existing container from pool */
-  int idx = mu_pool_get(ctx, ctx->container_pool, MU_CONTAINERPOOL_SIZE, id);
+  int idx = mu_pool_get(ctx, &ctx->container_pool, id);
   if (idx >= 0) {
     if (ctx->containers[idx].open || ~opt & MU_OPT_CLOSED) {
-      mu_pool_update(ctx, ctx->container_pool, idx);
+      mu_pool_update(ctx, &ctx->container_pool, idx);
     }
     return &ctx->containers[idx];
   }
   if (opt & MU_OPT_CLOSED) { return NULL; }
   /* container not found in pool: init new container */
-  idx = mu_pool_init(ctx, ctx->container_pool, MU_CONTAINERPOOL_SIZE, id);
+  idx = mu_pool_init(ctx, &ctx->container_pool, id);
   cnt = &ctx->containers[idx];
   memset(cnt, 0, sizeof(*cnt));
   cnt->open = 1;
@@ -335,7 +562,10 @@ mu_Container* mu_get_container(mu_Context *ctx, const char *name) {
 
 
 void mu_bring_to_front(mu_Context *ctx, mu_Container *cnt) {
+  /* already in front, keep the root order as it is */
+  if (cnt->zindex > 0 && cnt->zindex == ctx->last_zindex) { return; }
   cnt->zindex = ++ctx->last_zindex;
+  ctx->zindex_changed = 1;
 }
 
 
@@ -343,33 +573,139 @@ void mu_bring_to_front(mu_Context *ctx, mu_Container *cnt) {
 ** pool
 **============================================================================*/
 
-int mu_pool_init(mu_Context *ctx, mu_PoolItem *items, int len, mu_Id id) {
-  int i, n = -1, f = ctx->frame;
-  for (i = 0; i < len; i++) {
-    if (items[i].last_update < f) {
-      f = items[i].last_update;
-      n = i;
+/* pools map ids to a fixed number of items. lookups go through an
+** open-addressing index (linear probing, at most half full) and items are
+** kept on a list ordered from most to least recently updated, so getting,
+** updating and evicting an item are all O(1) regardless of the pool size.
+** unused items have an id of 0 and are not in the index */
+
+static void pool_unlink(mu_Pool *pool, int idx) {
+  mu_PoolItem *item = &pool->items[idx];
+  if (item->prev >= 0) { pool->items[item->prev].next = item->next; }
+                  else { pool->lru_head = item->next; }
+  if (item->next >= 0) { pool->items[item->next].prev = item->prev; }
+                  else { pool->lru_tail = item->prev; }
+}
+
+
+static void pool_link_front(mu_Pool *pool, int idx) {
+  mu_PoolItem *item = &pool->items[idx];
+  item->prev = -1;
+  item->next = pool->lru_head;
+  if (pool->lru_head >= 0) { pool->items[pool->lru_head].prev = idx; }
+                      else { pool->lru_tail = idx; }
+  pool->lru_head = idx;
+}
+
+
+static void pool_link_back(mu_Pool *pool, int idx) {
+  mu_PoolItem *item = &pool->items[idx];
+  item->next = -1;
+  item->prev = pool->lru_tail;
+  if (pool->lru_tail >= 0) { pool->items[pool->lru_tail].next = idx; }
+                      else { pool->lru_head = idx; }
+  pool->lru_tail = idx;
+}
+
+
+static int pool_slot(mu_Pool *pool, mu_Id id) {
+  id ^= id >> 16;
+  id *= 0x45d9f3b;
+  id ^= id >> 16;
+  return id & pool->index_mask;
+}
+
+
+static void pool_index_insert(mu_Pool *pool, int idx) {
+  int i = pool_slot(pool, pool->items[idx].id);
+  while (pool->index[i] >= 0) { i = (i + 1) & pool->index_mask; }
+  pool->index[i] = idx;
+}
+
+
+static void pool_index_remove(mu_Pool *pool, int idx) {
+  int i = pool_slot(pool, pool->items[idx].id);
+  int j, k;
+  while (pool->index[i] != idx) { i = (i + 1) & pool->index_mask; }
+  /* shift later entries of the probe run back into the hole, leaving only
+  ** those whose home slot lies cyclically within (i, j] */
+  for (j = i;;) {
+    j = (j + 1) & pool->index_mask;
+    if (pool->index[j] < 0) { break; }
+    k = pool_slot(pool, pool->items[pool->index[j]].id);
+    if (j > i ? (k <= i || k > j) : (k <= i && k > j)) {
+      pool->index[i] = pool->index[j];
+      i = j;
     }
   }
-  expect(n > -1);
-  items[n].id = id;
-  mu_pool_update(ctx, items, n);
-  return n;
+  pool->index[i] = -1;
 }
 
 
-int mu_pool_get(mu_Context *ctx, mu_PoolItem *items, int len, mu_Id id) {
+static void pool_init_items(mu_Pool *pool) {
   int i;
+  pool->lru_head = pool->lru_tail = -1;
+  for (i = 0; i <= pool->index_mask; i++) { pool->index[i] = -1; }
+  for (i = 0; i < pool->len; i++) {
+    pool->items[i].id = 0;
+    pool->items[i].last_update = 0;
+    pool_link_back(pool, i);
+  }
+}
+
+
+int mu_pool_init(mu_Context *ctx, mu_Pool *pool, mu_Id id) {
+  /* reuse the least recently updated item */
+  int n = pool->lru_tail;
+  if (pool->items[n].last_update >= ctx->frame) {
+    overflow(pool == &ctx->container_pool ? "container pool" : "treenode pool",
+      pool->len);
+  }
+  if (pool->items[n].id) {
+    pool_index_remove(pool, n);
+  } else if (++pool->count > pool->peak) {
+    pool->peak = pool->count;
+  }
+  pool->items[n].id = id;
+  if (id) { pool_index_insert(pool, n); }
+  mu_pool_update(ctx, pool, n);
+  return n;
+}
+
+
+int mu_pool_get(mu_Context *ctx, mu_Pool *pool, mu_Id id) {
+  int i = pool_slot(pool, id);
   unused(ctx);
-  for (i = 0; i < len; i++) {
-    if (items[i].id == id) { return i; }
+  while (pool->index[i] >= 0) {
+    if (pool->items[pool->index[i]].id == id) { return pool->index[i]; }
+    i = (i + 1) & pool->index_mask;
   }
   return -1;
 }
 
 
-void mu_pool_update(mu_Context *ctx, mu_PoolItem *items, int idx) {
-  items[idx].last_update = ctx->frame;
+void mu_pool_update(mu_Context *ctx, mu_Pool *pool, int idx) {
+  if (ctx->cache_recording && pool == &ctx->treenode_pool) {
+    cache_record_treenode(ctx, pool->items[idx].id);
+  }
+  pool->items[idx].last_update = ctx->frame;
+  if (pool->lru_head != idx) {
+    pool_unlink(pool, idx);
+    pool_link_front(pool, idx);
+  }
+}
+
+
+void mu_pool_remove(mu_Context *ctx, mu_Pool *pool, int idx) {
+  unused(ctx);
+  if (pool->items[idx].id) {
+    pool_index_remove(pool, idx);
+    pool->count--;
+  }
+  pool->items[idx].id = 0;
+  pool->items[idx].last_update = 0;
+  pool_unlink(pool, idx);
+  pool_link_back(pool, idx);
 }
 
 
@@ -415,7 +751,8 @@ void mu_input_keyup(mu_Context *ctx, int key) {
 void mu_input_text(mu_Context *ctx, const char *text) {
   int len = strlen(ctx->input_text);
   int size = strlen(text) + 1;
-  expect(len + size <= (int) sizeof(ctx->input_text));
+  ctx->input_text = buffer_reserve(ctx->input_text, &ctx->input_text_cap,
+    len + size, 1);
   memcpy(ctx->input_text + len, text, size);
 }
 
@@ -424,23 +761,79 @@ void mu_input_text(mu_Context *ctx, const char *text) {
 ** commandlist
 **============================================================================*/
 
+/* the command list is a chain of chunks which are kept across frames. every
+** chunk keeps room for one jump command past its last command; when a command
+** does not fit, that jump is written to link the chunk to the next one, so
+** iterating the list only ever follows jumps */
+
+static mu_CommandChunk* alloc_command_chunk(int size) {
+  mu_CommandChunk *chunk;
+  size = mu_max(size, MU_COMMANDCHUNK_SIZE);
+  chunk = malloc(sizeof(mu_CommandChunk) + size);
+  expect(chunk != NULL);
+  chunk->next = NULL;
+  chunk->size = size;
+  chunk->items = (char*) (chunk + 1);
+  return chunk;
+}
+
+
+static void next_command_chunk(mu_Context *ctx, int size) {
+  mu_CommandList *list = &ctx->command_list;
+  mu_CommandChunk *chunk;
+  mu_Command *jump;
+  size += sizeof(mu_JumpCommand);
+  /* first command of the first frame */
+  if (!list->head) {
+    list->head = list->chunk = alloc_command_chunk(size);
+    list->capacity += list->head->size;
+    return;
+  }
+  /* reuse the following chunk if it is large enough, otherwise insert a new
+  ** one in front of it so it can still be reused by later chunks */
+  chunk = list->chunk->next;
+  if (!chunk || chunk->size < size) {
+    chunk = alloc_command_chunk(size);
+    chunk->next = list->chunk->next;
+    list->chunk->next = chunk;
+    list->capacity += chunk->size;
+  }
+  jump = (mu_Command*) (list->chunk->items + list->idx);
+  jump->base.type = MU_COMMAND_JUMP;
+  jump->base.size = sizeof(mu_JumpCommand);
+  jump->jump.dst = chunk->items;
+  list->used += sizeof(mu_JumpCommand);
+  list->chunk = chunk;
+  list->idx = 0;
+}
+
+
 mu_Command* mu_push_command(mu_Context *ctx, int type, int size) {
-  mu_Command *cmd = (mu_Command*) (ctx->command_list.items + ctx->command_list.idx);
-  expect(ctx->command_list.idx + size < MU_COMMANDLIST_SIZE);
+  mu_CommandList *list = &ctx->command_list;
+  mu_Command *cmd;
+  if (!list->chunk ||
+      list->idx + size + (int) sizeof(mu_JumpCommand) > list->chunk->size
+  ) {
+    next_command_chunk(ctx, size);
+  }
+  cmd = (mu_Command*) (list->chunk->items + list->idx);
   cmd->base.type = type;
   cmd->base.size = size;
-  ctx->command_list.idx += size;
+  list->idx += size;
+  list->used += size;
+  if (list->used > list->peak) { list->peak = list->used; }
   return cmd;
 }
 
 
 int mu_next_command(mu_Context *ctx, mu_Command **cmd) {
+  if (!ctx->command_list.chunk) { return 0; }
   if (*cmd) {
     *cmd = (mu_Command*) (((char*) *cmd) + (*cmd)->base.size);
   } else {
-    *cmd = (mu_Command*) ctx->command_list.items;
+    *cmd = (mu_Command*) ctx->command_list.head->items;
   }
-  while ((char*) *cmd != ctx->command_list.items + ctx->command_list.idx) {
+  while ((char*) *cmd != command_list_end(ctx)) {
     if ((*cmd)->type != MU_COMMAND_JUMP) { return 1; }
     *cmd = (*cmd)->jump.dst;
   }
@@ -559,7 +952,7 @@ void mu_layout_end_column(mu_Context *ctx) {
 void mu_layout_row(mu_Context *ctx, int items, const int *widths, int height) {
   mu_Layout *layout = get_layout(ctx);
   if (widths) {
-    expect(items <= MU_MAX_WIDTHS);
+    if (items > ctx->config.max_widths) { overflow("row width", ctx->config.max_widths); }
     memcpy(layout->widths, widths, items * sizeof(widths[0]));
   }
   layout->items = items;
@@ -635,6 +1028,253 @@ mu_Rect mu_layout_next(mu_Context *ctx) {
 }
 
 
+/*============================================================================
+** hit grid
+**============================================================================*/
+
+/* every frame the clipped rects of controls and root containers are listed,
+** and on the first mu_hit_test() of the frame they are put in a grid of
+** MU_HITGRID_CELL sized cells, hashed into MU_HITGRID_BUCKETS lists. a query
+** then finds the control under a point in the last frame by looking at a
+** single cell, no matter how many controls there are. root containers are
+** added with an id of 0 so they hide the controls below */
+
+static mu_Rect hit_grid_rect = { 0, 0, 0x4000, 0x4000 };
+
+#define hit_grid_bucket(grid, x, y) \
+  (&(grid)->buckets[((unsigned) (x) * 73856093u ^ (unsigned) (y) * 19349663u) \
+    & (MU_HITGRID_BUCKETS - 1)])
+
+
+static void hit_grid_add(mu_Context *ctx, mu_Id id, mu_Rect rect) {
+  mu_HitGrid *grid = &ctx->hit_grid;
+  mu_HitEntry *e;
+  if (rect.w <= 0 || rect.h <= 0) { return; }
+  grid->entries = buffer_reserve(grid->entries, &grid->cap,
+    grid->count + 1, sizeof(mu_HitEntry));
+  e = &grid->entries[grid->count++];
+  e->id = id;
+  e->rect = rect;
+  e->zindex = ctx->hit_zindex;
+  grid->built = 0;
+}
+
+
+static void hit_grid_build(mu_HitGrid *grid) {
+  int i, x, y, x1, y1, x2, y2;
+  memset(grid->buckets, 0xff, sizeof(grid->buckets));
+  grid->cell_count = 0;
+  for (i = 0; i < grid->count; i++) {
+    mu_Rect rect = intersect_rects(grid->entries[i].rect, hit_grid_rect);
+    if (rect.w <= 0 || rect.h <= 0) { continue; }
+    x1 = rect.x / MU_HITGRID_CELL; x2 = (rect.x + rect.w - 1) / MU_HITGRID_CELL;
+    y1 = rect.y / MU_HITGRID_CELL; y2 = (rect.y + rect.h - 1) / MU_HITGRID_CELL;
+    grid->cells = buffer_reserve(grid->cells, &grid->cell_cap,
+      grid->cell_count + (x2 - x1 + 1) * (y2 - y1 + 1), sizeof(mu_HitCell));
+    for (y = y1; y <= y2; y++) {
+      for (x = x1; x <= x2; x++) {
+        int *bucket = hit_grid_bucket(grid, x, y);
+        grid->cells[grid->cell_count].entry = i;
+        grid->cells[grid->cell_count].next = *bucket;
+        *bucket = grid->cell_count++;
+      }
+    }
+  }
+  grid->built = 1;
+}
+
+
+mu_Id mu_hit_test(mu_Context *ctx, mu_Vec2 pos) {
+  mu_HitGrid *grid = &ctx->hit_grid;
+  int i, best = -1;
+  if (pos.x < 0 || pos.y < 0) { return 0; }
+  if (!grid->built) { hit_grid_build(grid); }
+  i = *hit_grid_bucket(grid, pos.x / MU_HITGRID_CELL, pos.y / MU_HITGRID_CELL);
+  /* cells are listed from the last added entry, which is drawn on top */
+  for (; i >= 0; i = grid->cells[i].next) {
+    mu_HitEntry *e = &grid->entries[grid->cells[i].entry];
+    if (!rect_overlaps_vec2(e->rect, pos)) { continue; }
+    if (best < 0 || e->zindex > grid->entries[best].zindex) {
+      best = grid->cells[i].entry;
+    }
+  }
+  return best >= 0 ? grid->entries[best].id : 0;
+}
+
+
+/*============================================================================
+** layout cache
+**============================================================================*/
+
+/* a cached region records the commands and the resulting layout state of the
+** widgets between mu_begin_cached() and mu_end_cached(). on following frames
+** the recording is replayed instead of laying the widgets out again as long as
+** the caller's version, the clip rect and the layout state the region starts
+** from are unchanged, and nothing could interact with the region's controls:
+** the mouse is outside all of them and none of them is hovered or focused.
+** regions must not contain containers; nested regions are recorded as part of
+** the outermost one */
+
+static void cache_save_layout(mu_Context *ctx, mu_Layout *dst, int *widths) {
+  mu_Layout *layout = get_layout(ctx);
+  *dst = *layout;
+  dst->widths = NULL;
+  memcpy(widths, layout->widths, ctx->config.max_widths * sizeof(int));
+}
+
+
+static int same_rect(mu_Rect a, mu_Rect b) {
+  return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+
+static int same_vec2(mu_Vec2 a, mu_Vec2 b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+
+static int cache_same_layout(mu_Context *ctx, mu_LayoutCache *cache) {
+  mu_Layout *a = get_layout(ctx), *b = &cache->layout_in;
+  return same_rect(a->body, b->body) && same_rect(a->next, b->next) &&
+    same_vec2(a->position, b->position) && same_vec2(a->size, b->size) &&
+    same_vec2(a->max, b->max) && a->items == b->items &&
+    a->item_index == b->item_index && a->next_row == b->next_row &&
+    a->next_type == b->next_type && a->indent == b->indent &&
+    memcmp(a->widths, cache->widths, a->items * sizeof(int)) == 0;
+}
+
+
+static int cache_replay(mu_Context *ctx, mu_LayoutCache *cache, int version) {
+  mu_Layout *layout = get_layout(ctx);
+  mu_Rect clip = mu_get_clip_rect(ctx);
+  int *widths = layout->widths;
+  int i, size;
+  if (!cache->valid || cache->version != version) { return 0; }
+  if (!same_rect(clip, cache->clip)) { return 0; }
+  if (!cache_same_layout(ctx, cache)) { return 0; }
+  if (rect_overlaps_vec2(cache->bounds, ctx->mouse_pos)) { return 0; }
+  for (i = 0; i < cache->control_count; i++) {
+    mu_Id id = cache->controls[i];
+    if (id == ctx->hover || id == ctx->focus) { return 0; }
+  }
+  /* treenodes opened inside the region keep their pool items alive */
+  for (i = 0; i < cache->treenode_count; i++) {
+    if (mu_pool_get(ctx, &ctx->treenode_pool, cache->treenodes[i]) < 0) { return 0; }
+  }
+  for (i = 0; i < cache->treenode_count; i++) {
+    int idx = mu_pool_get(ctx, &ctx->treenode_pool, cache->treenodes[i]);
+    mu_pool_update(ctx, &ctx->treenode_pool, idx);
+  }
+  for (i = 0; i < cache->control_count; i++) {
+    hit_grid_add(ctx, cache->controls[i], cache->control_rects[i]);
+  }
+  for (i = 0; i < cache->commands_size; i += size) {
+    mu_Command *src = (mu_Command*) (cache->commands + i);
+    size = src->base.size;
+    memcpy(mu_push_command(ctx, src->type, size), src, size);
+  }
+  *layout = cache->layout_out;
+  layout->widths = widths;
+  memcpy(widths, cache->widths + ctx->config.max_widths,
+    ctx->config.max_widths * sizeof(int));
+  return 1;
+}
+
+
+static void cache_record_control(mu_Context *ctx, mu_Id id, mu_Rect rect,
+  mu_Rect hit)
+{
+  mu_LayoutCache *cache = ctx->cache_recording;
+  /* a control drawn hovered or focused must not be replayed that way */
+  if (id == ctx->hover || id == ctx->focus ||
+      rect_overlaps_vec2(rect, ctx->mouse_pos)) { cache->valid = 0; }
+  if (cache->control_count == 0) {
+    cache->bounds = rect;
+  } else {
+    int x1 = mu_min(cache->bounds.x, rect.x);
+    int y1 = mu_min(cache->bounds.y, rect.y);
+    int x2 = mu_max(cache->bounds.x + cache->bounds.w, rect.x + rect.w);
+    int y2 = mu_max(cache->bounds.y + cache->bounds.h, rect.y + rect.h);
+    cache->bounds = mu_rect(x1, y1, x2 - x1, y2 - y1);
+  }
+  cache->controls = buffer_reserve(cache->controls, &cache->control_cap,
+    cache->control_count + 1, sizeof(mu_Id));
+  cache->control_rects = buffer_reserve(cache->control_rects,
+    &cache->control_rect_cap, cache->control_count + 1, sizeof(mu_Rect));
+  cache->controls[cache->control_count] = id;
+  cache->control_rects[cache->control_count] = hit;
+  cache->control_count++;
+}
+
+
+static void cache_record_treenode(mu_Context *ctx, mu_Id id) {
+  mu_LayoutCache *cache = ctx->cache_recording;
+  cache->treenodes = buffer_reserve(cache->treenodes, &cache->treenode_cap,
+    cache->treenode_count + 1, sizeof(mu_Id));
+  cache->treenodes[cache->treenode_count++] = id;
+}
+
+
+int mu_begin_cached(mu_Context *ctx, mu_Id id, int version) {
+  mu_Pool *pool = &ctx->layout_cache_pool;
+  mu_LayoutCache *cache;
+  int idx;
+  if (ctx->cache_depth++ > 0) { return 0; }
+  idx = mu_pool_get(ctx, pool, id);
+  if (idx >= 0) {
+    cache = &ctx->layout_caches[idx];
+    mu_pool_update(ctx, pool, idx);
+    if (cache_replay(ctx, cache, version)) {
+      ctx->cache_depth--;
+      return 1;
+    }
+  } else {
+    /* every entry is already used this frame: leave the region uncached */
+    if (pool->items[pool->lru_tail].last_update >= ctx->frame) { return 0; }
+    idx = mu_pool_init(ctx, pool, id);
+    cache = &ctx->layout_caches[idx];
+  }
+  /* record the region */
+  cache->valid = 1;
+  cache->version = version;
+  cache->clip = mu_get_clip_rect(ctx);
+  cache_save_layout(ctx, &cache->layout_in, cache->widths);
+  cache->commands_size = 0;
+  cache->control_count = 0;
+  cache->treenode_count = 0;
+  cache->bounds = mu_rect(0, 0, 0, 0);
+  ctx->cache_recording = cache;
+  ctx->cache_start = command_list_end(ctx);
+  return 0;
+}
+
+
+void mu_end_cached(mu_Context *ctx) {
+  mu_LayoutCache *cache = ctx->cache_recording;
+  mu_Command *cmd;
+  char *end;
+  expect(ctx->cache_depth > 0);
+  if (--ctx->cache_depth > 0 || !cache) { return; }
+  ctx->cache_recording = NULL;
+  if (!cache->valid) { return; }
+  /* copy the region's commands, following the jumps between chunks */
+  end = command_list_end(ctx);
+  cmd = (mu_Command*) ctx->cache_start;
+  while ((char*) cmd != end) {
+    if (cmd->type == MU_COMMAND_JUMP) {
+      cmd = cmd->jump.dst;
+      continue;
+    }
+    cache->commands = buffer_reserve(cache->commands, &cache->commands_cap,
+      cache->commands_size + cmd->base.size, 1);
+    memcpy(cache->commands + cache->commands_size, cmd, cmd->base.size);
+    cache->commands_size += cmd->base.size;
+    cmd = (mu_Command*) (((char*) cmd) + cmd->base.size);
+  }
+  cache_save_layout(ctx, &cache->layout_out, cache->widths + ctx->config.max_widths);
+}
+
+
 /*============================================================================
 ** controls
 **============================================================================*/
@@ -688,7 +1328,18 @@ int mu_mouse_over(mu_Context *ctx, mu_Rect rect) {
 
 
 void mu_update_control(mu_Context *ctx, mu_Id id, mu_Rect rect, int opt) {
-  int mouseover = mu_mouse_over(ctx, rect);
+  mu_Rect hit = mu_rect(0, 0, 0, 0);
+  int mouseover;
+
+  if (~opt & MU_OPT_NOINTERACT) { hit = intersect_rects(rect, mu_get_clip_rect(ctx)); }
+  hit_grid_add(ctx, id, hit);
+  if (ctx->cache_recording) { cache_record_control(ctx, id, rect, hit); }
+  /* nothing to do for a control that is neither under the mouse, hovered
+  ** nor focused, which is the case of most of them */
+  if (id != ctx->hover && id != ctx->focus &&
+      !rect_overlaps_vec2(rect, ctx->mouse_pos)) { return; }
+
+  mouseover = mu_mouse_over(ctx, rect);
 
   if (ctx->focus == id) { ctx->updated_focus = 1; }
   if (opt & MU_OPT_NOINTERACT) { return; }
@@ -709,28 +1360,102 @@ void mu_update_control(mu_Context *ctx, mu_Id id, mu_Rect rect, int opt) {
 }
 
 
-void mu_text(mu_Context *ctx, const char *text) {
+/* counts the utf-8 characters in the `len` bytes at `str` */
+static int utf8_count(const char *str, int len) {
+  int count = 0;
+  while (len-- > 0) { count += (*str++ & 0xc0) != 0x80; }
+  return count;
+}
+
+
+/* word-wraps `text` to `width`, storing the start and end offset of each line
+** in `cache`. with a monospace font (`ctx->text_advance` set) widths are
+** computed from the number of characters in words instead of calling
+** `ctx->text_width` */
+static void wrap_text(mu_Context *ctx, mu_TextCache *cache, const char *text,
+  mu_Font font, int width)
+{
   const char *start, *end, *p = text;
-  int width = -1;
-  mu_Font font = ctx->style->font;
-  mu_Color color = ctx->style->colors[MU_COLOR_TEXT];
-  mu_layout_begin_column(ctx);
-  mu_layout_row(ctx, 1, &width, ctx->text_height(font));
+  int adv = ctx->text_advance;
+  cache->line_count = 0;
   do {
-    mu_Rect r = mu_layout_next(ctx);
     int w = 0;
     start = end = p;
     do {
       const char* word = p;
       while (*p && *p != ' ' && *p != '\n') { p++; }
-      w += ctx->text_width(font, word, p - word);
-      if (w > r.w && end != start) { break; }
-      w += ctx->text_width(font, p, 1);
+      w += adv ? utf8_count(word, p - word) * adv
+               : ctx->text_width(font, word, p - word);
+      if (w > width && end != start) { break; }
+      w += adv ? adv : ctx->text_width(font, p, 1);
       end = p++;
     } while (*end && *end != '\n');
-    mu_draw_text(ctx, font, start, end - start, mu_vec2(r.x, r.y), color);
+    cache->lines = buffer_reserve(cache->lines, &cache->line_cap,
+      cache->line_count * 2 + 2, sizeof(int));
+    cache->lines[cache->line_count * 2] = start - text;
+    cache->lines[cache->line_count * 2 + 1] = end - text;
+    cache->line_count++;
     p = end + 1;
   } while (*end);
+}
+
+
+/* line breaks are cached per text content, font and width, so only entries
+** for a width no longer used age out when the layout is resized */
+static mu_TextCache* get_wrapped_text(mu_Context *ctx, const char *text,
+  mu_Font font, int width)
+{
+  mu_Pool *pool = &ctx->text_cache_pool;
+  mu_TextCache *cache;
+  int size = strlen(text) + 1;
+  mu_Id id = HASH_INITIAL;
+  int idx;
+  hash(&id, text, size);
+  hash(&id, &width, sizeof(width));
+  hash(&id, &font, sizeof(font));
+  idx = mu_pool_get(ctx, pool, id);
+  if (idx >= 0) {
+    cache = &ctx->text_caches[idx];
+    mu_pool_update(ctx, pool, idx);
+    if (cache->font == font && cache->width == width &&
+        cache->text_size == size && memcmp(cache->text, text, size) == 0
+    ) {
+      return cache;
+    }
+  } else if (pool->items[pool->lru_tail].last_update >= ctx->frame) {
+    /* every entry is already used this frame: wrap without caching */
+    cache = &ctx->text_caches[pool->len];
+    wrap_text(ctx, cache, text, font, width);
+    return cache;
+  } else {
+    idx = mu_pool_init(ctx, pool, id);
+    cache = &ctx->text_caches[idx];
+  }
+  cache->font = font;
+  cache->width = width;
+  cache->text = buffer_reserve(cache->text, &cache->text_cap, size, 1);
+  memcpy(cache->text, text, size);
+  cache->text_size = size;
+  wrap_text(ctx, cache, text, font, width);
+  return cache;
+}
+
+
+void mu_text(mu_Context *ctx, const char *text) {
+  mu_TextCache *lines;
+  int i, width = -1;
+  mu_Font font = ctx->style->font;
+  mu_Color color = ctx->style->colors[MU_COLOR_TEXT];
+  mu_Rect r;
+  mu_layout_begin_column(ctx);
+  mu_layout_row(ctx, 1, &width, ctx->text_height(font));
+  r = mu_layout_next(ctx);
+  lines = get_wrapped_text(ctx, text, font, r.w);
+  for (i = 0; i < lines->line_count; i++) {
+    int start = lines->lines[i * 2], end = lines->lines[i * 2 + 1];
+    if (i > 0) { r = mu_layout_next(ctx); }
+    mu_draw_text(ctx, font, text + start, end - start, mu_vec2(r.x, r.y), color);
+  }
   mu_layout_end_column(ctx);
 }
 
@@ -790,6 +1515,8 @@ int mu_textbox_raw(mu_Context *ctx, char *buf, int bufsz, mu_Id id, mu_Rect r,
     /* handle text input */
     int len = strlen(buf);
     int n = mu_min(bufsz - len - 1, (int) strlen(ctx->input_text));
+    /* don't cut a character in half when the buffer is full */
+    while (n > 0 && (ctx->input_text[n] & 0xc0) == 0x80) { n--; }
     if (n > 0) {
       memcpy(buf + len, ctx->input_text, n);
       len += n;
@@ -938,7 +1665,7 @@ static int header(mu_Context *ctx, const char *label, int istreenode, int opt) {
   mu_Rect r;
   int active, expanded;
   mu_Id id = mu_get_id(ctx, label, strlen(label));
-  int idx = mu_pool_get(ctx, ctx->treenode_pool, MU_TREENODEPOOL_SIZE, id);
+  int idx = mu_pool_get(ctx, &ctx->treenode_pool, id);
   int width = -1;
   mu_layout_row(ctx, 1, &width, 0);
 
@@ -952,10 +1679,10 @@ static int header(mu_Context *ctx, const char *label, int istreenode, int opt) {
 
   /* update pool ref */
   if (idx >= 0) {
-    if (active) { mu_pool_update(ctx, ctx->treenode_pool, idx); }
-           else { memset(&ctx->treenode_pool[idx], 0, sizeof(mu_PoolItem)); }
+    if (active) { mu_pool_update(ctx, &ctx->treenode_pool, idx); }
+           else { mu_pool_remove(ctx, &ctx->treenode_pool, idx); }
   } else if (active) {
-    mu_pool_init(ctx, ctx->treenode_pool, MU_TREENODEPOOL_SIZE, id);
+    mu_pool_init(ctx, &ctx->treenode_pool, id);
   }
 
   /* draw */
@@ -1064,6 +1791,7 @@ static void begin_root_container(mu_Context *ctx, mu_Container *cnt) {
   push(ctx->container_stack, cnt);
   /* push container to roots list and push head command */
   push(ctx->root_list, cnt);
+  cnt->root_frame = ctx->frame;
   cnt->head = push_jump(ctx, NULL);
   /* set as hover root if the mouse is overlapping this container and it has a
   ** higher zindex than the current hover root */
@@ -1072,6 +1800,8 @@ static void begin_root_container(mu_Context *ctx, mu_Container *cnt) {
   ) {
     ctx->next_hover_root = cnt;
   }
+  ctx->hit_zindex = cnt->zindex;
+  hit_grid_add(ctx, 0, cnt->rect);
   /* clipping is reset here in case a root-container is made within
   ** another root-containers's begin/end block; this prevents the inner
   ** root-container being clipped to the outer */
@@ -1080,14 +1810,23 @@ static void begin_root_container(mu_Context *ctx, mu_Container *cnt) {
 
 
 static void end_root_container(mu_Context *ctx) {
+  int i;
   /* push tail 'goto' jump command and set head 'skip' command. the final steps
   ** on initing these are done in mu_end() */
   mu_Container *cnt = mu_get_current_container(ctx);
   cnt->tail = push_jump(ctx, NULL);
-  cnt->head->jump.dst = ctx->command_list.items + ctx->command_list.idx;
+  cnt->head->jump.dst = command_list_end(ctx);
   /* pop base clip rect and container */
   mu_pop_clip_rect(ctx);
   pop_container(ctx);
+  /* controls which follow belong to the enclosing root container, if any */
+  ctx->hit_zindex = 0;
+  for (i = ctx->container_stack.idx - 1; i >= 0; i--) {
+    if (ctx->container_stack.items[i]->head) {
+      ctx->hit_zindex = ctx->container_stack.items[i]->zindex;
+      break;
+    }
+  }
 }
 
 
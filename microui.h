@@ -10,7 +10,7 @@
 
 #define MU_VERSION "2.02"
 
-#define MU_COMMANDLIST_SIZE     (256 * 1024)
+#define MU_COMMANDCHUNK_SIZE    (32 * 1024)
 #define MU_ROOTLIST_SIZE        32
 #define MU_CONTAINERSTACK_SIZE  32
 #define MU_CLIPSTACK_SIZE       32
@@ -18,13 +18,17 @@
 #define MU_LAYOUTSTACK_SIZE     16
 #define MU_CONTAINERPOOL_SIZE   48
 #define MU_TREENODEPOOL_SIZE    48
+#define MU_LAYOUTCACHE_SIZE     64
+#define MU_TEXTCACHE_SIZE       128
+#define MU_HITGRID_CELL         32
+#define MU_HITGRID_BUCKETS      1024
 #define MU_MAX_WIDTHS           16
 #define MU_REAL                 float
 #define MU_REAL_FMT             "%.3g"
 #define MU_SLIDER_FMT           "%.2f"
 #define MU_MAX_FMT              127
 
-#define mu_stack(T, n)          struct { int idx; T items[n]; }
+#define mu_stack(T)             struct { int idx, cap, peak; T *items; }
 #define mu_min(a, b)            ((a) < (b) ? (a) : (b))
 #define mu_max(a, b)            ((a) > (b) ? (a) : (b))
 #define mu_clamp(x, a, b)       mu_min(b, mu_max(a, x))
@@ -103,7 +107,19 @@ enum {
   MU_KEY_CTRL         = (1 << 1),
   MU_KEY_ALT          = (1 << 2),
   MU_KEY_BACKSPACE    = (1 << 3),
-  MU_KEY_RETURN       = (1 << 4)
+  MU_KEY_RETURN       = (1 << 4),
+  MU_KEY_TAB          = (1 << 5),
+  MU_KEY_ESCAPE       = (1 << 6),
+  MU_KEY_DELETE       = (1 << 7),
+  MU_KEY_INSERT       = (1 << 8),
+  MU_KEY_LEFT         = (1 << 9),
+  MU_KEY_RIGHT        = (1 << 10),
+  MU_KEY_UP           = (1 << 11),
+  MU_KEY_DOWN         = (1 << 12),
+  MU_KEY_HOME         = (1 << 13),
+  MU_KEY_END          = (1 << 14),
+  MU_KEY_PAGEUP       = (1 << 15),
+  MU_KEY_PAGEDOWN     = (1 << 16)
 };
 
 
@@ -115,7 +131,15 @@ typedef void* mu_Font;
 typedef struct { int x, y; } mu_Vec2;
 typedef struct { int x, y, w, h; } mu_Rect;
 typedef struct { unsigned char r, g, b, a; } mu_Color;
-typedef struct { mu_Id id; int last_update; } mu_PoolItem;
+typedef struct { mu_Id id; int last_update; int prev, next; } mu_PoolItem;
+
+typedef struct {
+  mu_PoolItem *items;
+  int *index;
+  int len, index_mask;
+  int count, peak;
+  int lru_head, lru_tail;
+} mu_Pool;
 
 typedef struct { int type, size; } mu_BaseCommand;
 typedef struct { mu_BaseCommand base; void *dst; } mu_JumpCommand;
@@ -136,13 +160,27 @@ typedef union {
   mu_ImageCommand image;
 } mu_Command;
 
+typedef struct mu_CommandChunk {
+  struct mu_CommandChunk *next;
+  int size;
+  char *items;
+} mu_CommandChunk;
+
+typedef struct {
+  mu_CommandChunk *head, *chunk;
+  int idx;
+  int used;
+  int peak;
+  int capacity;
+} mu_CommandList;
+
 typedef struct {
   mu_Rect body;
   mu_Rect next;
   mu_Vec2 position;
   mu_Vec2 size;
   mu_Vec2 max;
-  int widths[MU_MAX_WIDTHS];
+  int *widths;
   int items;
   int item_index;
   int next_row;
@@ -158,6 +196,7 @@ typedef struct {
   mu_Vec2 scroll;
   int zindex;
   int open;
+  int root_frame;
 } mu_Container;
 
 typedef struct {
@@ -172,19 +211,75 @@ typedef struct {
   mu_Color colors[MU_COLOR_MAX];
 } mu_Style;
 
+typedef struct {
+  int root_list_size;
+  int container_stack_size;
+  int clip_stack_size;
+  int id_stack_size;
+  int layout_stack_size;
+  int max_widths;
+  int container_pool_size;
+  int treenode_pool_size;
+  int layout_cache_size;
+  int text_cache_size;
+} mu_Config;
+
+typedef struct {
+  int valid;
+  int version;
+  mu_Rect clip;
+  mu_Layout layout_in, layout_out;
+  int *widths;
+  mu_Rect bounds;
+  char *commands;
+  int commands_size, commands_cap;
+  mu_Id *controls;
+  mu_Rect *control_rects;
+  int control_count, control_cap, control_rect_cap;
+  mu_Id *treenodes;
+  int treenode_count, treenode_cap;
+} mu_LayoutCache;
+
+typedef struct { mu_Id id; mu_Rect rect; int zindex; } mu_HitEntry;
+typedef struct { int entry, next; } mu_HitCell;
+
+typedef struct {
+  mu_HitEntry *entries;
+  int count, cap;
+  mu_HitCell *cells;
+  int cell_count, cell_cap;
+  int built;
+  int buckets[MU_HITGRID_BUCKETS];
+} mu_HitGrid;
+
+typedef struct {
+  mu_Font font;
+  int width;
+  char *text;
+  int text_size, text_cap;
+  int *lines;
+  int line_count, line_cap;
+} mu_TextCache;
+
 struct mu_Context {
   /* callbacks */
   int (*text_width)(mu_Font font, const char *str, int len);
   int (*text_height)(mu_Font font);
   void (*draw_frame)(mu_Context *ctx, mu_Rect rect, int colorid);
+  int text_advance;
   /* core state */
+  mu_Config config;
+  void *arena;
   mu_Style _style;
   mu_Style *style;
   mu_Id hover;
   mu_Id focus;
   mu_Id last_id;
+  mu_Id next_hash;
+  int has_next_hash;
   mu_Rect last_rect;
   int last_zindex;
+  int zindex_changed;
   int updated_focus;
   int frame;
   mu_Container *hover_root;
@@ -193,16 +288,27 @@ struct mu_Context {
   char number_edit_buf[MU_MAX_FMT];
   mu_Id number_edit;
   /* stacks */
-  mu_stack(char, MU_COMMANDLIST_SIZE) command_list;
-  mu_stack(mu_Container*, MU_ROOTLIST_SIZE) root_list;
-  mu_stack(mu_Container*, MU_CONTAINERSTACK_SIZE) container_stack;
-  mu_stack(mu_Rect, MU_CLIPSTACK_SIZE) clip_stack;
-  mu_stack(mu_Id, MU_IDSTACK_SIZE) id_stack;
-  mu_stack(mu_Layout, MU_LAYOUTSTACK_SIZE) layout_stack;
+  mu_CommandList command_list;
+  mu_stack(mu_Container*) root_list;
+  mu_stack(mu_Container*) root_order;
+  mu_stack(mu_Container*) container_stack;
+  mu_stack(mu_Rect) clip_stack;
+  mu_stack(mu_Id) id_stack;
+  mu_stack(mu_Layout) layout_stack;
+  int *layout_widths;
   /* retained state pools */
-  mu_PoolItem container_pool[MU_CONTAINERPOOL_SIZE];
-  mu_Container containers[MU_CONTAINERPOOL_SIZE];
-  mu_PoolItem treenode_pool[MU_TREENODEPOOL_SIZE];
+  mu_Pool container_pool;
+  mu_Container *containers;
+  mu_Pool treenode_pool;
+  mu_Pool layout_cache_pool;
+  mu_LayoutCache *layout_caches;
+  mu_LayoutCache *cache_recording;
+  char *cache_start;
+  int cache_depth;
+  mu_Pool text_cache_pool;
+  mu_TextCache *text_caches;
+  mu_HitGrid hit_grid;
+  int hit_zindex;
   /* input state */
   mu_Vec2 mouse_pos;
   mu_Vec2 last_mouse_pos;
@@ -212,7 +318,8 @@ struct mu_Context {
   int mouse_pressed;
   int key_down;
   int key_pressed;
-  char input_text[32];
+  char *input_text; /* grown to fit a whole paste */
+  int input_text_cap;
 };
 
 
@@ -221,10 +328,14 @@ mu_Rect mu_rect(int x, int y, int w, int h);
 mu_Color mu_color(int r, int g, int b, int a);
 
 void mu_init(mu_Context *ctx);
+void mu_init_ex(mu_Context *ctx, const mu_Config *config);
+void mu_free(mu_Context *ctx);
 void mu_begin(mu_Context *ctx);
 void mu_end(mu_Context *ctx);
 void mu_set_focus(mu_Context *ctx, mu_Id id);
+mu_Id mu_hash(const void *data, int size);
 mu_Id mu_get_id(mu_Context *ctx, const void *data, int size);
+void mu_set_next_hash(mu_Context *ctx, mu_Id hash);
 void mu_push_id(mu_Context *ctx, const void *data, int size);
 void mu_pop_id(mu_Context *ctx);
 void mu_push_clip_rect(mu_Context *ctx, mu_Rect rect);
@@ -235,9 +346,10 @@ mu_Container* mu_get_current_container(mu_Context *ctx);
 mu_Container* mu_get_container(mu_Context *ctx, const char *name);
 void mu_bring_to_front(mu_Context *ctx, mu_Container *cnt);
 
-int mu_pool_init(mu_Context *ctx, mu_PoolItem *items, int len, mu_Id id);
-int mu_pool_get(mu_Context *ctx, mu_PoolItem *items, int len, mu_Id id);
-void mu_pool_update(mu_Context *ctx, mu_PoolItem *items, int idx);
+int mu_pool_init(mu_Context *ctx, mu_Pool *pool, mu_Id id);
+int mu_pool_get(mu_Context *ctx, mu_Pool *pool, mu_Id id);
+void mu_pool_update(mu_Context *ctx, mu_Pool *pool, int idx);
+void mu_pool_remove(mu_Context *ctx, mu_Pool *pool, int idx);
 
 void mu_input_mousemove(mu_Context *ctx, int x, int y);
 void mu_input_mousedown(mu_Context *ctx, int x, int y, int btn);
@@ -262,10 +374,13 @@ void mu_layout_begin_column(mu_Context *ctx);
 void mu_layout_end_column(mu_Context *ctx);
 void mu_layout_set_next(mu_Context *ctx, mu_Rect r, int relative);
 mu_Rect mu_layout_next(mu_Context *ctx);
+int mu_begin_cached(mu_Context *ctx, mu_Id id, int version);
+void mu_end_cached(mu_Context *ctx);
 
 void mu_draw_control_frame(mu_Context *ctx, mu_Id id, mu_Rect rect, int colorid, int opt);
 void mu_draw_control_text(mu_Context *ctx, const char *str, mu_Rect rect, int colorid, int opt);
 int mu_mouse_over(mu_Context *ctx, mu_Rect rect);
+mu_Id mu_hit_test(mu_Context *ctx, mu_Vec2 pos);
 void mu_update_control(mu_Context *ctx, mu_Id id, mu_Rect rect, int opt);
 
 #define mu_button(ctx, label)             mu_button_ex(ctx, label, 0, MU_OPT_ALIGNCENTER)
@@ -3,23 +3,39 @@ const Reconciler = require('react-reconciler');
 const { DefaultEventPriority } = require('react-reconciler/constants');
 const mukitty = require('./build/Release/mukitty.node');
 
-class ObjectIdGenerator {
-  constructor() {
-    this.idByTypes = {};
-  }
+// Host types owning retained native state (textbox buffer, focus/hover id).
+const WIDGET_TYPES = new Set([
+  'button',
+  'checkbox',
+  'slider',
+  'input',
+  'log',
+  'table',
+]);
 
-  nextId(type) {
-    if (!this.idByTypes[type]) {
-      this.idByTypes[type] = 0;
-    }
-    return this.idByTypes[type]++;
-  }
+// Element types whose subtree can be laid out once and replayed from the
+// native layout cache, and the types a cached subtree must not contain.
+const CACHED_TYPES = new Set(['row', 'col', 'header', 'tree']);
+const UNCACHED_TYPES = new Set([
+  'window',
+  'modal',
+  'panel',
+  'list',
+  'log',
+  'table',
+]);
 
-  reset() {
-    this.idByTypes = {};
-  }
-}
-const objectIdGenerator = new ObjectIdGenerator();
+// Flat render plan of the committed tree, rebuilt lazily after each commit.
+let renderPlan = null;
+// Instance ids; with the per-instance revision they version cached subtrees.
+let nextUid = 1;
+// Rows rendered around the visible window of a <list>.
+const LIST_OVERSCAN = 4;
+// <list> instances whose visible window changed during the last frame.
+const pendingLists = new Set();
+// How long an idle UI waits for input before running timers and commits,
+// in ms.
+const IDLE_POLL_MS = 16;
 
 const hostConfig = {
   noTimeout: -1,
@@ -32,6 +48,9 @@ const hostConfig = {
   setCurrentUpdatePriority: (priority) => {},
   resolveUpdatePriority: () => DefaultEventPriority,
 
+  getPublicInstance(instance) {
+    return instance;
+  },
   getRootHostContext(rootContainerInstance) {
     return 'root';
   },
@@ -39,7 +58,8 @@ const hostConfig = {
     return null;
   },
   resetAfterCommit: (...args) => {
-    objectIdGenerator.reset();
+    renderPlan = null;
+    mukitty.invalidate();
   },
   getChildHostContext: (...args) => {
     return 'urchild';
@@ -53,11 +73,14 @@ const hostConfig = {
     return {
       type: 'text',
       text,
+      uid: nextUid++,
+      revision: 0,
     };
   },
   resetTextContent(instance) {
     instance.children = [];
     instance.text = '';
+    instance.revision++;
   },
   createInstance(type, props, rootContainerInstance, _hostContext) {
     const elementProps = { ...props };
@@ -66,14 +89,46 @@ const hostConfig = {
     } else {
       elementProps.children = [];
     }
-    if (elementProps.id === undefined && type !== 'window') {
-      elementProps.id = objectIdGenerator.nextId(type);
-    }
 
-    return { type, ...elementProps };
+    const instance = { type, ...elementProps, uid: nextUid++, revision: 0 };
+    if (WIDGET_TYPES.has(type)) {
+      instance.slot = mukitty.allocWidget();
+    }
+    if (type === 'log') {
+      // Lines are pushed through a ref straight into the native ring buffer,
+      // without going through React state.
+      instance.append = (lines) => mukitty.logAppend(instance.slot, lines);
+      instance.clear = () => mukitty.logClear(instance.slot);
+    }
+    if (type === 'table') {
+      // Cells live in native memory; besides the `columns`/`data` props they
+      // can be updated in place through a ref.
+      instance.setColumn = (column, values, offset = 0) =>
+        mukitty.tableSetColumn(instance.slot, column, values, offset);
+      instance.setRowCount = (rows) =>
+        mukitty.tableSetRowCount(instance.slot, rows);
+      instance.sort = (column, desc = false) =>
+        mukitty.tableSort(instance.slot, column, desc);
+      syncTable(instance, {});
+    }
+    if (type === 'list') {
+      // Rows of a list are reconciled in their own root, holding only the
+      // visible window produced by renderItem.
+      instance.items = { children: [] };
+      instance.itemsContainer = createContainer(instance.items);
+      instance.window = null;
+    }
+    return instance;
   },
-  detachDeletedInstance(...args) {
-    return null;
+  detachDeletedInstance(instance) {
+    if (instance.slot !== undefined) {
+      mukitty.freeWidget(instance.slot);
+      instance.slot = undefined;
+    }
+    if (instance.itemsContainer) {
+      pendingLists.delete(instance);
+      MukittyRenderer.updateContainer(null, instance.itemsContainer);
+    }
   },
   removeChild(parentInstance, child) {
     const index = parentInstance.children.indexOf(child);
@@ -113,194 +168,538 @@ const hostConfig = {
   commitMount(instance, type, newProps) {},
   commitTextUpdate(textInstance, oldText, newText) {
     textInstance.text = newText;
+    textInstance.revision++;
   },
   commitUpdate(instance, tag, oldProps, newProps) {
     const { children, ...rest } = newProps;
     Object.assign(instance, rest);
+    instance.revision++;
+    if (instance.type === 'table') {
+      syncTable(instance, oldProps);
+    }
+    if (instance.type === 'list') {
+      // renderItem/itemCount may have changed: rebuild the visible rows.
+      instance.window = null;
+    }
   },
 };
 const MukittyRenderer = Reconciler(hostConfig);
 
-function renderTextElement(element) {
-  if (element.type === 'text') {
+function createContainer(root) {
+  return MukittyRenderer.createContainer(
+    root,
+    0,
+    null,
+    false,
+    null,
+    '',
+    console.error,
+    console.error,
+    console.error
+  );
+}
+
+function sameTitles(a, b) {
+  if (a === b) {
+    return true;
+  }
+  if (!a || !b || a.length !== b.length) {
+    return false;
+  }
+  return a.every((title, i) => title === b[i]);
+}
+
+// Upload the `columns`/`data` props of a <table>, skipping the columns whose
+// array didn't change since the previous props. Titles are compared by value,
+// as they are usually passed as an inline array.
+function syncTable(table, oldProps) {
+  const { columns, data } = table;
+  if (!sameTitles(columns, oldProps.columns)) {
+    mukitty.tableSetColumns(table.slot, columns ?? []);
+  }
+  // A different column count clears the table, retitling keeps the cells.
+  const newColumns = (columns?.length ?? 0) !== (oldProps.columns?.length ?? 0);
+  if (!data) {
+    return;
+  }
+  let rows = 0;
+  data.forEach((values, i) => {
+    if (newColumns || values !== oldProps.data?.[i]) {
+      mukitty.tableSetColumn(table.slot, i, values, 0);
+    }
+    rows = Math.max(rows, values.length);
+  });
+  mukitty.tableSetRowCount(table.slot, rows);
+}
+
+function updateListWindow(list, first, last) {
+  if (list.window && list.window[0] === first && list.window[1] === last) {
+    return;
+  }
+  list.window = [first, last];
+  pendingLists.add(list);
+}
+
+// Render the rows of lists scrolled during the frame. Done between frames so
+// the running plan never sees instances detached by the update.
+function flushListWindows() {
+  for (const list of pendingLists) {
+    const [first, last] = list.window;
+    const rows = [];
+    for (let i = first; i < last; i++) {
+      rows.push(
+        React.createElement('listitem', { key: i, index: i }, list.renderItem(i))
+      );
+    }
+    MukittyRenderer.updateContainer(rows, list.itemsContainer);
+  }
+  pendingLists.clear();
+}
+
+// Render plan op codes. Every committed tree is compiled once into a flat list
+// of ops which is replayed each frame until the next commit invalidates it.
+const Op = {
+  WINDOW: 0,
+  END_WINDOW: 1,
+  MODAL: 2,
+  BUTTON: 3,
+  ROW: 4,
+  END_ROW: 5,
+  COL: 6,
+  END_COL: 7,
+  LABEL: 8,
+  SLIDER: 9,
+  CHECKBOX: 10,
+  INPUT: 11,
+  TEXT: 12,
+  RECT: 13,
+  TREE: 14,
+  END_TREE: 15,
+  HEADER: 16,
+  IMG: 17,
+  PANEL: 18,
+  END_PANEL: 19,
+  LIST: 20,
+  END_LIST: 21,
+  LIST_ITEM: 22,
+  END_LIST_ITEM: 23,
+  LOG: 24,
+  TABLE: 25,
+  CACHE: 26,
+  END_CACHE: 27,
+};
+
+class RenderPlan {
+  constructor() {
+    this.ops = [];
+    // host instance of each op, read at run time for live props and callbacks
+    this.elements = [];
+    // prebuilt operand of each op (label text, Int32Array of row widths...)
+    this.args = [];
+    // for ops opening a closable container: index of its last op, so the
+    // whole subtree can be skipped when the container is closed
+    this.jumps = [];
+  }
+
+  emit(op, element, arg = null) {
+    this.ops.push(op);
+    this.elements.push(element);
+    this.args.push(arg);
+    this.jumps.push(0);
+    return this.ops.length - 1;
+  }
+
+  closeAt(begin) {
+    this.jumps[begin] = this.ops.length - 1;
+  }
+
+  finalize() {
+    this.ops = Int32Array.from(this.ops);
+    this.jumps = Int32Array.from(this.jumps);
+    return this;
+  }
+}
+
+function textContent(element) {
+  if (element.text !== undefined) {
     return element.text;
   }
-  return element.children?.map(renderTextElement).join('') || '';
+  return element.children?.map(textContent).join('') || '';
+}
+
+function compileChildren(plan, element) {
+  for (let child of element.children) {
+    compileElement(plan, child);
+  }
+}
+
+// Version of a subtree for the layout cache: a hash of the ids and revisions
+// of its instances, or null when it can't be cached.
+function subtreeVersion(element) {
+  let hash = 0x811c9dc5 | 0;
+  const visit = (node) => {
+    if (UNCACHED_TYPES.has(node.type)) return false;
+    hash = Math.imul(hash ^ (node.uid | 0), 16777619);
+    hash = Math.imul(hash ^ (node.revision | 0), 16777619);
+    return (node.children ?? []).every(visit);
+  };
+  return visit(element) ? hash : null;
+}
+
+// Children of a container, each wrapped in a cached region when possible.
+function compileBody(plan, element) {
+  for (let child of element.children) {
+    const version = CACHED_TYPES.has(child.type) ? subtreeVersion(child) : null;
+    if (version === null) {
+      compileElement(plan, child);
+      continue;
+    }
+    const begin = plan.emit(Op.CACHE, child, version);
+    compileElement(plan, child);
+    plan.emit(Op.END_CACHE, child);
+    plan.closeAt(begin);
+  }
 }
-function renderElement(element) {
+
+function compileElement(plan, element) {
   switch (element.type) {
     case 'window':
-      {
-        mukitty.beginWindow(element.id ?? 'root');
-        for (let child of element.children) {
-          renderElement(child);
-        }
-        mukitty.endWindow();
-      }
+      plan.emit(Op.WINDOW, element, element.id ?? 'root');
+      compileBody(plan, element);
+      plan.emit(Op.END_WINDOW, element);
       break;
     case 'modal':
       {
-        const open = mukitty.beginWindow(
-          element.title,
-          element.top,
-          element.left,
-          element.width,
-          element.height
-        );
-        if (open) {
-          for (let child of element.children) {
-            renderElement(child);
-          }
-          mukitty.endWindow();
-        } else {
-          element.onClose?.();
-        }
+        const begin = plan.emit(Op.MODAL, element, element.title);
+        compileBody(plan, element);
+        plan.emit(Op.END_WINDOW, element);
+        plan.closeAt(begin);
       }
       break;
     case 'button':
-      {
-        let text = '';
-        for (let child of element.children) {
-          text += renderTextElement(child);
-        }
-        if (mukitty.button(text)) {
-          element.onClick?.();
-        }
-      }
+      plan.emit(Op.BUTTON, element, textContent(element));
       break;
     case 'row':
-      {
-        const widths = element.widths ?? [];
-        mukitty.beginLayout(0, 0);
-        mukitty.layoutRow(element.height, ...widths);
-        for (let child of element.children) {
-          renderElement(child);
-        }
-        mukitty.endLayout();
-      }
+      plan.emit(Op.ROW, element, Int32Array.from(element.widths ?? []));
+      compileChildren(plan, element);
+      plan.emit(Op.END_ROW, element);
       break;
     case 'col':
-      {
-        mukitty.beginColumn();
-        for (let child of element.children) {
-          renderElement(child);
-        }
-        mukitty.endColumn();
-      }
+      plan.emit(Op.COL, element);
+      compileChildren(plan, element);
+      plan.emit(Op.END_COL, element);
       break;
     case 'label':
-      {
-        let text = '';
-        for (let child of element.children) {
-          text += renderTextElement(child);
-        }
-        mukitty.label(text);
-      }
+      plan.emit(Op.LABEL, element, textContent(element));
       break;
     case 'slider':
-      {
-        const val = mukitty.slider(element.min, element.max, element.value);
-        element.onChange?.(val);
-      }
+      plan.emit(Op.SLIDER, element);
       break;
     case 'checkbox':
-      {
-        const checked = mukitty.checkbox(element.checked, element.label);
-        element.onChange?.(checked);
-      }
+      plan.emit(Op.CHECKBOX, element);
       break;
     case 'input':
-      {
-        const { text, submit } = mukitty.textbox(element.id, element.value);
-        element.onChange?.(text);
-        if (submit) {
-          element.onSubmit?.(text);
-        }
-      }
+      plan.emit(Op.INPUT, element);
       break;
     case 'text':
-      {
-        let text = '';
-        for (let child of element.children) {
-          text += renderTextElement(child);
-        }
-        mukitty.text(text);
-      }
+      plan.emit(Op.TEXT, element, textContent(element));
       break;
     case 'rect':
-      {
-        mukitty.rect(element.color || 0xffffff);
-      }
+      plan.emit(Op.RECT, element);
       break;
     case 'tree':
       {
-        const open = mukitty.beginTreeNode(element.title, element.startOpened);
-        if (!open) {
-          element.onClose?.();
-          return;
-        }
-        for (let child of element.children) {
-          renderElement(child);
-        }
-        mukitty.endTreeNode();
+        const begin = plan.emit(Op.TREE, element);
+        compileChildren(plan, element);
+        plan.emit(Op.END_TREE, element);
+        plan.closeAt(begin);
       }
       break;
     case 'header':
       {
-        const open = mukitty.header(element.title, element.startOpened);
-        if (!open) {
-          element.onClose?.();
-          return;
-        }
-        for (let child of element.children) {
-          renderElement(child);
-        }
+        const begin = plan.emit(Op.HEADER, element);
+        compileChildren(plan, element);
+        plan.closeAt(begin);
       }
       break;
     case 'img':
-      {
-        mukitty.beginLayout(element.width ?? 0, element.height ?? 0);
-        mukitty.image(element.src);
-        mukitty.endLayout();
-      }
+      plan.emit(Op.IMG, element);
       break;
     case 'panel':
-      {
-        mukitty.beginPanel(element.title);
-        for (let child of element.children) {
-          renderElement(child);
-        }
-        mukitty.endPanel();
-      }
+      plan.emit(Op.PANEL, element);
+      compileBody(plan, element);
+      plan.emit(Op.END_PANEL, element);
+      break;
+    case 'log':
+      plan.emit(Op.LOG, element);
+      break;
+    case 'table':
+      plan.emit(Op.TABLE, element);
+      break;
+    case 'list':
+      plan.emit(Op.LIST, element, element.title ?? 'list');
+      compileChildren(plan, element.items);
+      plan.emit(Op.END_LIST, element);
+      break;
+    case 'listitem':
+      plan.emit(Op.LIST_ITEM, element);
+      compileChildren(plan, element);
+      plan.emit(Op.END_LIST_ITEM, element);
       break;
     default:
       throw `Unknown element type: ${element.type}`;
   }
 }
 
-exports.render = async (element) => {
+// Native hash of a widget label, recomputed only when the label changes so
+// the id of the widget doesn't need to hash it every frame.
+function labelHash(element, label) {
+  if (element.hashedLabel !== label) {
+    element.hashedLabel = label;
+    element.labelHash = mukitty.hash(label);
+  }
+  return element.labelHash;
+}
+
+function compilePlan(root) {
+  const plan = new RenderPlan();
+  compileElement(plan, root);
+  return plan.finalize();
+}
+
+function runPlan(plan) {
+  const { ops, elements, args, jumps } = plan;
+  for (let pc = 0; pc < ops.length; pc++) {
+    const element = elements[pc];
+    switch (ops[pc]) {
+      case Op.WINDOW:
+        mukitty.beginWindow(args[pc]);
+        break;
+      case Op.END_WINDOW:
+        mukitty.endWindow();
+        break;
+      case Op.MODAL:
+        {
+          const open = mukitty.beginWindow(
+            element.title,
+            element.top,
+            element.left,
+            element.width,
+            element.height,
+            labelHash(element, element.title)
+          );
+          if (!open) {
+            element.onClose?.();
+            pc = jumps[pc];
+          }
+        }
+        break;
+      case Op.BUTTON:
+        if (
+          mukitty.button(args[pc], element.slot, labelHash(element, args[pc]))
+        ) {
+          element.onClick?.();
+        }
+        break;
+      case Op.ROW:
+        mukitty.beginLayout(0, 0);
+        mukitty.layoutRow(element.height ?? 0, args[pc]);
+        break;
+      case Op.END_ROW:
+        mukitty.endLayout();
+        break;
+      case Op.COL:
+        mukitty.beginColumn();
+        break;
+      case Op.END_COL:
+        mukitty.endColumn();
+        break;
+      case Op.LABEL:
+        mukitty.label(args[pc]);
+        break;
+      case Op.SLIDER:
+        {
+          const val = mukitty.slider(
+            element.min,
+            element.max,
+            element.value,
+            element.slot
+          );
+          element.onChange?.(val);
+        }
+        break;
+      case Op.CHECKBOX:
+        {
+          const checked = mukitty.checkbox(
+            element.checked,
+            element.label,
+            element.slot
+          );
+          element.onChange?.(checked);
+        }
+        break;
+      case Op.INPUT:
+        {
+          const { text, submit } = mukitty.textbox(element.slot, element.value);
+          element.onChange?.(text);
+          if (submit) {
+            element.onSubmit?.(text);
+          }
+        }
+        break;
+      case Op.TEXT:
+        mukitty.text(args[pc]);
+        break;
+      case Op.RECT:
+        mukitty.rect(element.color || 0xffffff);
+        break;
+      case Op.TREE:
+        if (
+          !mukitty.beginTreeNode(
+            element.title,
+            element.startOpened,
+            labelHash(element, element.title)
+          )
+        ) {
+          element.onClose?.();
+          pc = jumps[pc];
+        }
+        break;
+      case Op.END_TREE:
+        mukitty.endTreeNode();
+        break;
+      case Op.HEADER:
+        if (
+          !mukitty.header(
+            element.title,
+            element.startOpened,
+            labelHash(element, element.title)
+          )
+        ) {
+          element.onClose?.();
+          pc = jumps[pc];
+        }
+        break;
+      case Op.IMG:
+        mukitty.beginLayout(element.width ?? 0, element.height ?? 0);
+        mukitty.image(element.src);
+        mukitty.endLayout();
+        break;
+      case Op.PANEL:
+        mukitty.beginPanel(element.title);
+        break;
+      case Op.END_PANEL:
+        mukitty.endPanel();
+        break;
+      case Op.LOG:
+        mukitty.log(element.slot, element.capacity ?? 0);
+        break;
+      case Op.TABLE:
+        mukitty.table(element.slot, element.rowHeight ?? 0);
+        break;
+      case Op.LIST:
+        {
+          const [first, last] = mukitty.beginList(
+            args[pc],
+            element.itemCount ?? 0,
+            element.itemHeight ?? 0,
+            element.overscan ?? LIST_OVERSCAN
+          );
+          updateListWindow(element, first, last);
+        }
+        break;
+      case Op.END_LIST:
+        mukitty.endList();
+        break;
+      case Op.LIST_ITEM:
+        mukitty.beginListItem(element.index);
+        break;
+      case Op.END_LIST_ITEM:
+        mukitty.endListItem();
+        break;
+      case Op.CACHE:
+        if (mukitty.beginCached(element.uid, args[pc])) {
+          pc = jumps[pc];
+        }
+        break;
+      case Op.END_CACHE:
+        mukitty.endCached();
+        break;
+    }
+  }
+}
+
+// `options` sets microui capacities (see mukitty.stats() for the peaks):
+// rootListSize, containerStackSize, clipStackSize, idStackSize,
+// layoutStackSize, maxWidths, containerPoolSize, treenodePoolSize,
+// layoutCacheSize, textCacheSize.
+// `motion` picks how mouse motion reaches the UI: 'coalesce' (default) uses
+// the latest position of each frame, 'drag' gives every sample of a drag its
+// own frame and 'all' does so for all motion.
+// The UI renders at the terminal's pixel resolution when it's known;
+// `downscale` divides it, trading sharpness for less data per frame.
+// `onKey(pressed, down)` is called with the Key bits pressed since the last
+// frame and held down, when a key is pressed. Ctrl+C quits.
+// `record` writes the input to a file; `replay` runs it again headless, as
+// fast as it can, and stops at its end. stats().replayMismatches counts the
+// frames that came out different.
+// `lowLatency` renders as soon as input arrives instead of on the next frame
+// tick, no more often than `maxFps` allows (120 by default, 60 otherwise).
+// stats() reports the input to screen latency percentiles, in microseconds.
+exports.render = async (element, options = {}) => {
   const root = { type: 'window', children: [] };
-  const container = MukittyRenderer.createContainer(
-    root,
-    0,
-    null,
-    false,
-    null,
-    '',
-    console.error,
-    console.error,
-    console.error
-  );
+  const container = createContainer(root);
   MukittyRenderer.updateContainer(element, container);
 
-  mukitty.init();
+  mukitty.init(options);
+  // The event loop turns the signal into a callback; mukitty waits for the
+  // resize to settle before reading the new size.
+  const onResize = () => mukitty.windowResized();
+  process.on('SIGWINCH', onResize);
   while (true) {
     const stop = mukitty.handleInputs();
     if (stop) break;
+    const pressed = mukitty.keyPressed();
+    if (pressed && options.onKey) {
+      options.onKey(pressed, mukitty.keyDown());
+    }
+    // Nothing changed since the last frame: wait for input instead of
+    // redrawing it, then let timers and commits run.
+    if (!mukitty.shouldRender()) {
+      mukitty.waitInput(options.replay ? 0 : IDLE_POLL_MS);
+      await new Promise((r) => setImmediate(r));
+      continue;
+    }
     mukitty.begin();
-    renderElement(root);
+    if (!renderPlan) {
+      renderPlan = compilePlan(root);
+    }
+    runPlan(renderPlan);
     mukitty.end();
+    flushListWindows();
     await new Promise((r) => setImmediate(r));
   }
+  process.off('SIGWINCH', onResize);
   mukitty.close();
 };
+
+// MU_KEY_* bits of microui.h, for onKey.
+exports.Key = Object.freeze({
+  SHIFT: 1 << 0,
+  CTRL: 1 << 1,
+  ALT: 1 << 2,
+  BACKSPACE: 1 << 3,
+  RETURN: 1 << 4,
+  TAB: 1 << 5,
+  ESCAPE: 1 << 6,
+  DELETE: 1 << 7,
+  INSERT: 1 << 8,
+  LEFT: 1 << 9,
+  RIGHT: 1 << 10,
+  UP: 1 << 11,
+  DOWN: 1 << 12,
+  HOME: 1 << 13,
+  END: 1 << 14,
+  PAGEUP: 1 << 15,
+  PAGEDOWN: 1 << 16,
+});
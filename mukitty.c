@@ -6,6 +6,7 @@
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/time.h>
 #include <termios.h>
@@ -23,16 +24,20 @@
 #include "c64_font.h"
 
 #define FONT_SIZE 8
-#define RESW 6  // Character width in pixels.
-#define RESH 12 // Character height in pixels.
+#define RESW 6  // Character width in pixels, if the terminal doesn't tell.
+#define RESH 12 // Character height in pixels, if the terminal doesn't tell.
+
+#define RESIZE_DEBOUNCE 0.1 // Seconds a resize must settle before it's applied.
 
 #define MAX_STR_LEN 256
-#define MAX_INPUT_IDS 32
+#define LOG_CAPACITY 10000 // Default number of lines kept by a <log>.
 #define TARGET_FPS 60.0
 #define FRAME_TIME (1.0 / TARGET_FPS)
+#define LOW_LATENCY_FPS 120 // Default rate cap when rendering on input.
+#define LATENCY_SAMPLES 1024 // Input latencies kept for the stats.
 
 #define TRACE_LOGS 1
-#define LOG(fmt, ...) TRACE_LOGS ? printf("\33[2K\r" fmt, ##__VA_ARGS__) : 0
+#define LOG(fmt, ...) TRACE_LOGS ? fprintf(term_out, "\33[2K\r" fmt, ##__VA_ARGS__) : 0
 
 struct img_data {
     unsigned char *data;
@@ -43,6 +48,66 @@ struct img_data {
 hm_declare(ImageCache, const char *, struct img_data);
 ImageCache image_cache = {0};
 
+/* Ring buffer of lines shown by a <log> element. */
+struct text_log {
+    char **lines;
+    int capacity;
+    int head;     // index of the oldest line
+    int count;
+    int last_max; // max scroll of the previous frame, to follow the tail
+};
+
+/* Columnar cell storage of a <table> element. */
+struct table_column {
+    char *title;
+    bool numeric; // cells live in `numbers`, otherwise in `strings`
+    bool typed;   // type fixed by the first values written
+    double *numbers;
+    char **strings;
+    int width;    // cached text width of the widest cell, without padding
+};
+
+struct data_table {
+    struct table_column *columns;
+    int column_count;
+    int row_count;
+    int row_capacity;
+    int *order;        // display order of the rows
+    int sort_column;   // -1 when unsorted
+    bool sort_desc;
+    bool order_dirty;  // rows changed since the last sort
+};
+
+/* Retained native state of a host instance. Slots are allocated by the
+ * reconciler in createInstance and released in detachDeletedInstance, so the
+ * state survives reordering and their (heap) address is a stable microui id. */
+struct widget_slot {
+    char *text;      // textbox buffer, grown on demand
+    size_t text_cap;
+    int checked;     // checkbox state
+    mu_Real value;   // slider value
+    struct text_log *log;
+    struct data_table *table;
+};
+da_declare(WidgetSlots, struct widget_slot *);
+da_declare(FreeSlots, int);
+static WidgetSlots widget_slots = {0};
+static FreeSlots free_slots = {0};
+
+/* Virtualized list being emitted: rows sit at a fixed pitch inside a panel
+ * and only the visible window of rows is emitted by the caller. */
+struct list_state {
+    int count;       // total number of rows
+    int item_height; // row height in pixels
+    int pitch;       // row height plus spacing
+};
+da_declare(ListStack, struct list_state);
+static ListStack list_stack = {0};
+
+// Layout sizes saved by beginLayout() and restored by endLayout().
+da_declare(SizeStack, mu_Vec2);
+static SizeStack size_stack = {0};
+
 #define node_parse_args()                                 \
     size_t argc;                                          \
     napi_get_cb_info(env, info, &argc, NULL, NULL, NULL); \
@@ -85,20 +150,48 @@ struct {
     int width;               // display width in pixels.
     int height;              // display height in pixels.
     unsigned long render_id; // Unique ID for the current render session.
+    int motion;              // MOTION_* policy for mouse motion reports.
+    bool mouse_pixels;       // Mouse reports are in pixels (SGR-Pixels, 1016).
+    int cell_width;          // terminal cell size in screen pixels, 0 if
+    int cell_height;         // unknown.
+    int downscale;           // framebuffer pixels per cell are divided by this.
+    bool key_releases;       // The terminal reports key releases (kitty
+                             // keyboard protocol).
+    bool low_latency;        // Render as soon as input arrives.
+    double frame_time;       // Shortest time between frames, in seconds.
 } Config;
+
+/* How mouse motion reports reach microui. With any-event tracking the terminal
+ * sends a report per pointer move, so by default only the latest position of
+ * a frame is used. Drag-heavy UIs can ask for every sample of a drag, or of
+ * all motion, each in its own frame. */
+enum {
+    MOTION_COALESCE,
+    MOTION_DRAG,
+    MOTION_ALL,
+};
 static struct {
     int x, y, w, h;
     bool enabled;
 } clip_rect = {0};
 
 struct termios orig_termios;
+static FILE *term_out; // stdout, or /dev/null when replaying headless
 static uint8_t *fb = NULL; // Framebuffer pointer
 static int frame_number = 0;
 static mu_Context ctx;
 
+// Frames left to render before the UI is idle and frames can be skipped.
+// Input, React commits, widget data updates and resizes reset it to 2, as
+// microui only settles hover and focus on the frame after the input.
+static int dirty_frames = 2;
+
+static void mark_dirty() {
+    dirty_frames = 2;
+}
+
 // Function to encode data to base64
-size_t base64_encode(size_t input_length, char *encoded_data) {
-    const unsigned char *data = fb;
+size_t base64_encode(const unsigned char *data, size_t input_length, char *encoded_data) {
     const char base64_table[] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     size_t i, j;
@@ -120,9 +213,9 @@ size_t base64_encode(size_t input_length, char *encoded_data) {
 }
 
 void disable_raw_mode() {
-    /* Disable mouse reporting */
-    printf("\033[?1006l\033[?1003l");
-    fflush(stdout);
+    /* Disable mouse reporting and bracketed paste, restore the keyboard mode */
+    fprintf(term_out, "\033[?2004l\033[?1016l\033[?1006l\033[?1003l\033[<u");
+    fflush(term_out);
     tcsetattr(STDIN_FILENO, TCSAFLUSH, &orig_termios);
 }
 // In enable_raw_mode(), add these lines before tcsetattr
@@ -139,9 +232,26 @@ void enable_raw_mode() {
     raw.c_cc[VTIME] = 0;
     tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
 
-    /* Enable mouse reporting. 1003h = Any Event, 1006h = SGR-Pixel reporting */
-    printf("\033[?1003h\033[?1006h");
-    fflush(stdout);
+    /* Enable mouse reporting. 1003h = Any Event, 1006h = SGR reporting.
+     * 2004h = bracketed paste, so a paste arrives as one text input. */
+    fprintf(term_out, "\033[?1003h\033[?1006h\033[?2004h");
+
+    /* Ask for SGR-Pixels reporting (1016h) and whether it's now set: reports
+     * are read as pixels once the terminal confirms it. If the cell size in
+     * pixels isn't known from the window size, ask for it first. */
+    struct winsize w;
+    if (ioctl(STDIN_FILENO, TIOCGWINSZ, &w) == 0 && w.ws_xpixel && w.ws_ypixel) {
+        Config.cell_width = w.ws_xpixel / w.ws_col;
+        Config.cell_height = w.ws_ypixel / w.ws_row;
+    } else {
+        fprintf(term_out, "\033[16t");
+    }
+    fprintf(term_out, "\033[?1016h\033[?1016$p");
+
+    /* Kitty keyboard protocol: disambiguate escape codes (1) and report key
+     * releases (2), then ask which flags the terminal took. */
+    fprintf(term_out, "\033[>3u\033[?u");
+    fflush(term_out);
 }
 
 int kbhit() {
@@ -163,7 +273,7 @@ void kitty_update_display() {
     }
 
     // Encode the bitmap data to base64
-    base64_encode(bitmap_size, encoded_data);
+    base64_encode(fb, bitmap_size, encoded_data);
     encoded_data[encoded_size] = '\0'; // Null-terminate the string
 
     // Send Kitty Graphics Protocol escape sequence with base64 data.
@@ -174,49 +284,49 @@ void kitty_update_display() {
         int more_chunks = (encoded_offset + chunk_size) < encoded_size;
         if (encoded_offset == 0) {
             if (Config.ghostty_mode) {
-                printf("\033_Ga=%c,i=%lu,f=24,s=%d,v=%d,q=2,c=%d,r=%d,m=%d;",
-                       frame_number == 0 ? 'T' : 't', Config.render_id, Config.width,
-                       Config.height, Config.width_chars, Config.height_chars,
-                       more_chunks);
+                fprintf(term_out, "\033_Ga=%c,i=%lu,f=24,s=%d,v=%d,q=2,c=%d,r=%d,m=%d;",
+                        frame_number == 0 ? 'T' : 't', Config.render_id, Config.width,
+                        Config.height, Config.width_chars, Config.height_chars,
+                        more_chunks);
             } else {
                 if (frame_number == 0) {
-                    printf(
+                    fprintf(term_out,
                         "\033_Ga=T,i=%lu,f=24,s=%d,v=%d,q=2,"
                         "c=%d,r=%d,m=%d;",
                         Config.render_id, Config.width, Config.height,
                         Config.width_chars, Config.height_chars, more_chunks);
                 } else {
-                    printf("\033_Ga=f,r=1,i=%lu,f=24,x=0,y=0,s=%d,v=%d,m=%d;",
-                           Config.render_id, Config.width, Config.height, more_chunks);
+                    fprintf(term_out, "\033_Ga=f,r=1,i=%lu,f=24,x=0,y=0,s=%d,v=%d,m=%d;",
+                            Config.render_id, Config.width, Config.height, more_chunks);
                 }
             }
         } else {
             if (Config.ghostty_mode) {
-                printf("\033_Gm=%d;", more_chunks);
+                fprintf(term_out, "\033_Gm=%d;", more_chunks);
             } else {
                 // Chunks after the first just require the raw data and the
                 // more flag.
                 if (frame_number == 0) {
-                    printf("\033_Gm=%d;", more_chunks);
+                    fprintf(term_out, "\033_Gm=%d;", more_chunks);
                 } else {
-                    printf("\033_Ga=f,r=1,m=%d;", more_chunks);
+                    fprintf(term_out, "\033_Ga=f,r=1,m=%d;", more_chunks);
                 }
             }
         }
 
         // Transfer payload.
         size_t this_size = more_chunks ? 4096 : encoded_size - encoded_offset;
-        fwrite(encoded_data + encoded_offset, this_size, 1, stdout);
-        printf("\033\\");
-        fflush(stdout);
+        fwrite(encoded_data + encoded_offset, this_size, 1, term_out);
+        fprintf(term_out, "\033\\");
+        fflush(term_out);
         encoded_offset += this_size;
     }
 
     if (Config.kitty_mode && frame_number > 0) {
         // In Kitty mode we need to emit the "a" action to update
         // our area with the new frame.
-        printf("\033_Ga=a,c=1,i=%lu;", Config.render_id);
-        printf("\033\\");
+        fprintf(term_out, "\033_Ga=a,c=1,i=%lu;", Config.render_id);
+        fprintf(term_out, "\033\\");
     }
 
     /* When the image is created, add a newline so that the cursor
@@ -224,128 +334,909 @@ void kitty_update_display() {
      * corner. */
     if (frame_number == 0) {
         if (TRACE_LOGS && Config.ghostty_mode)
-            printf("\r\n");
+            fprintf(term_out, "\r\n");
         frame_number++;
     }
 
-    fflush(stdout);
+    fflush(term_out);
     // Clean up
     free(encoded_data);
 }
 
+// Update a region of the displayed image in place (Kitty only): the pixels of
+// `r` are sent as an edit of the current frame, shown by kitty_show_frame().
+void kitty_update_region(mu_Rect r) {
+    size_t row_size = r.w * 3;
+    size_t bitmap_size = row_size * r.h;
+    size_t encoded_size = 4 * ((bitmap_size + 2) / 3);
+    uint8_t *region = malloc(bitmap_size);
+    char *encoded_data = malloc(encoded_size);
+
+    if (!region || !encoded_data) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(region);
+        free(encoded_data);
+        return;
+    }
+    for (int row = 0; row < r.h; row++)
+        memcpy(region + row * row_size, fb + ((r.y + row) * Config.width + r.x) * 3, row_size);
+    base64_encode(region, bitmap_size, encoded_data);
+
+    size_t encoded_offset = 0;
+    while (encoded_offset < encoded_size) {
+        size_t this_size = encoded_size - encoded_offset;
+        if (this_size > 4096)
+            this_size = 4096;
+        int more_chunks = encoded_offset + this_size < encoded_size;
+        if (encoded_offset == 0) {
+            fprintf(term_out, "\033_Ga=f,r=1,i=%lu,f=24,x=%d,y=%d,s=%d,v=%d,q=2,m=%d;",
+                    Config.render_id, r.x, r.y, r.w, r.h, more_chunks);
+        } else {
+            fprintf(term_out, "\033_Ga=f,r=1,m=%d;", more_chunks);
+        }
+        fwrite(encoded_data + encoded_offset, this_size, 1, term_out);
+        fprintf(term_out, "\033\\");
+        encoded_offset += this_size;
+    }
+    free(region);
+    free(encoded_data);
+}
+
+void kitty_show_frame() {
+    fprintf(term_out, "\033_Ga=a,c=1,i=%lu;", Config.render_id);
+    fprintf(term_out, "\033\\");
+    fflush(term_out);
+}
+
+struct widget_slot *get_widget_slot(napi_env env, napi_value value) {
+    int32_t index;
+    if (napi_get_value_int32(env, value, &index) != napi_ok)
+        return NULL;
+    if (index < 0 || (size_t)index >= widget_slots.count)
+        return NULL;
+    return widget_slots.items[index];
+}
+
+void widget_slot_reserve(struct widget_slot *slot, size_t size) {
+    if (size <= slot->text_cap)
+        return;
+    size_t cap = slot->text_cap ? slot->text_cap : MAX_STR_LEN;
+    while (cap < size)
+        cap *= 2;
+    slot->text = realloc(slot->text, cap);
+    if (!slot->text_cap)
+        slot->text[0] = '\0';
+    slot->text_cap = cap;
+}
+
+void text_log_free(struct text_log *log) {
+    if (!log)
+        return;
+    for (int i = 0; i < log->count; i++)
+        free(log->lines[(log->head + i) % log->capacity]);
+    free(log->lines);
+    free(log);
+}
+
+// Get the log of a slot, creating it or changing its capacity (keeping the
+// newest lines) as needed.
+struct text_log *widget_slot_log(struct widget_slot *slot, int capacity) {
+    struct text_log *log = slot->log;
+    if (log && (capacity <= 0 || capacity == log->capacity))
+        return log;
+    if (capacity <= 0)
+        capacity = LOG_CAPACITY;
+
+    struct text_log *resized = calloc(1, sizeof(*resized));
+    resized->lines = malloc(capacity * sizeof(char *));
+    resized->capacity = capacity;
+    if (log) {
+        int drop = log->count > capacity ? log->count - capacity : 0;
+        for (int i = 0; i < log->count; i++) {
+            char *line = log->lines[(log->head + i) % log->capacity];
+            if (i < drop)
+                free(line);
+            else
+                resized->lines[resized->count++] = line;
+        }
+        resized->last_max = log->last_max;
+        free(log->lines);
+        free(log);
+    }
+    return slot->log = resized;
+}
+
+void text_log_append(struct text_log *log, const char *line, size_t len) {
+    if (len && line[len - 1] == '\r')
+        len--;
+    char *copy = malloc(len + 1);
+    memcpy(copy, line, len);
+    copy[len] = '\0';
+    if (log->count == log->capacity) {
+        free(log->lines[log->head]);
+        log->lines[log->head] = copy;
+        log->head = (log->head + 1) % log->capacity;
+    } else {
+        log->lines[(log->head + log->count++) % log->capacity] = copy;
+    }
+}
+
+// Append a string to a log, one line per '\n' separated segment.
+void text_log_append_text(struct text_log *log, const char *text, size_t len) {
+    const char *end = text + len;
+    if (!len)
+        text_log_append(log, text, 0);
+    while (text < end) {
+        const char *nl = memchr(text, '\n', end - text);
+        size_t line_len = nl ? (size_t)(nl - text) : (size_t)(end - text);
+        text_log_append(log, text, line_len);
+        text += line_len + 1;
+    }
+}
+
+void text_log_append_value(napi_env env, struct text_log *log, napi_value value) {
+    size_t len;
+    if (napi_get_value_string_utf8(env, value, NULL, 0, &len) != napi_ok)
+        return;
+    char stack_buf[MAX_STR_LEN];
+    char *buf = len < sizeof(stack_buf) ? stack_buf : malloc(len + 1);
+    napi_get_value_string_utf8(env, value, buf, len + 1, NULL);
+    text_log_append_text(log, buf, len);
+    if (buf != stack_buf)
+        free(buf);
+}
+
+double get_time_sec() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + (tv.tv_usec / 1000000.0);
+}
+
+// Input recording, to replay an interaction headless and get the same frames.
+// A header with the terminal mode and size is followed by records of the
+// input read by process_input(), of the resizes and of the hash of each frame
+// rendered, each tagged with the frames rendered before it and the time since
+// the start in microseconds. Values are little endian.
+#define RECORD_MAGIC "MKR1"
+
+enum {
+    RECORD_INPUT = 'i', // u16 length, then the bytes
+    RECORD_SIZE = 's',  // u16 columns, rows, x pixels, y pixels
+    RECORD_FRAME = 'f', // u32 hash of the framebuffer
+};
+
+static struct {
+    FILE *file;
+    bool replaying;
+    double start;        // when recording started
+    double time;         // of the input being parsed, in seconds
+    uint32_t frames;     // frames rendered so far
+    int next;            // replay: type of the next record, 0 at the end
+    uint32_t next_frame; // and its frame and time
+    uint32_t next_time;
+    struct winsize size; // replay: terminal size
+    int mismatches;      // replay: frames not matching the recording
+} recording = {0};
+
+static void write_u16(uint32_t value) {
+    fputc(value & 0xff, recording.file);
+    fputc((value >> 8) & 0xff, recording.file);
+}
+
+static void write_u32(uint32_t value) {
+    write_u16(value & 0xffff);
+    write_u16(value >> 16);
+}
+
+static uint32_t read_u16() {
+    uint32_t lo = fgetc(recording.file) & 0xff;
+    return lo | (fgetc(recording.file) & 0xff) << 8;
+}
+
+static uint32_t read_u32() {
+    uint32_t lo = read_u16();
+    return lo | read_u16() << 16;
+}
+
+static double recording_time() {
+    return get_time_sec() - recording.start;
+}
+
+static void write_record(int type, double time) {
+    fputc(type, recording.file);
+    write_u32(recording.frames);
+    write_u32((uint32_t)(time * 1000000.0));
+}
+
+static void write_size(struct winsize *size) {
+    write_u16(size->ws_col);
+    write_u16(size->ws_row);
+    write_u16(size->ws_xpixel);
+    write_u16(size->ws_ypixel);
+}
+
+static void read_size(struct winsize *size) {
+    size->ws_col = read_u16();
+    size->ws_row = read_u16();
+    size->ws_xpixel = read_u16();
+    size->ws_ypixel = read_u16();
+}
+
+static void replay_read_next() {
+    int type = fgetc(recording.file);
+    recording.next = type == EOF ? 0 : type;
+    recording.next_frame = read_u32();
+    recording.next_time = read_u32();
+}
+
+// Whether the next record is of `type` and due: at its frame, or now if the
+// UI is idle and won't render up to it.
+static bool replay_due(int type) {
+    return recording.next == type &&
+           (recording.next_frame <= recording.frames || dirty_frames == 0);
+}
+
+static void start_recording(const char *path, struct winsize *size) {
+    recording.file = fopen(path, "wb");
+    if (!recording.file) {
+        fprintf(stderr, "Error: can't write the recording '%s'.\n", path);
+        exit(1);
+    }
+    recording.start = get_time_sec();
+    fwrite(RECORD_MAGIC, 1, 4, recording.file);
+    fputc(Config.ghostty_mode, recording.file);
+    write_size(size);
+}
+
+// Replays take the terminal from the recording, and write the frames nowhere.
+static void start_replay(const char *path) {
+    char magic[4] = {0};
+    recording.file = fopen(path, "rb");
+    if (!recording.file || fread(magic, 1, 4, recording.file) != 4 ||
+        memcmp(magic, RECORD_MAGIC, 4)) {
+        fprintf(stderr, "Error: '%s' is not a recording.\n", path);
+        exit(1);
+    }
+    recording.replaying = true;
+    Config.ghostty_mode = fgetc(recording.file) == 1;
+    Config.kitty_mode = !Config.ghostty_mode;
+    Config.render_id = 1;
+    read_size(&recording.size);
+    replay_read_next();
+    term_out = fopen("/dev/null", "w");
+}
+
+// Checks the frame just rendered against the recording, or records its hash.
+static void record_frame() {
+    uint32_t hash = recording.file ? mu_hash(fb, Config.width * Config.height * 3) : 0;
+    if (recording.file && !recording.replaying) {
+        write_record(RECORD_FRAME, recording_time());
+        write_u32(hash);
+    }
+    while (recording.replaying && recording.next == RECORD_FRAME &&
+           recording.next_frame <= recording.frames) {
+        if (read_u32() != hash || recording.next_frame != recording.frames)
+            recording.mismatches++;
+        replay_read_next();
+    }
+    recording.frames++;
+}
+
+static void stop_recording() {
+    if (!recording.file)
+        return;
+    fclose(recording.file);
+    if (recording.replaying) {
+        fclose(term_out);
+        term_out = stdout;
+    }
+    recording.file = NULL;
+    recording.replaying = false;
+}
+
 struct winsize get_terminal_size() {
+    if (recording.replaying)
+        return recording.size;
     struct winsize w;
     ioctl(STDIN_FILENO, TIOCGWINSZ, &w);
     return w;
 }
 
-int process_input(mu_Context *ctx) {
-    int bytes_waiting = kbhit();
-    if (!bytes_waiting)
-        return 0;
+// Terminal size, read again only once a SIGWINCH has settled: resizing a
+// window sends dozens of them, and each new size reallocates the framebuffer
+// and repaints everything.
+static struct winsize term_size;
+static double resize_time = 0; // last SIGWINCH, 0 when none is pending.
+
+static void read_terminal_size() {
+    term_size = get_terminal_size();
+    // The cell size changes with the font size.
+    if (term_size.ws_xpixel && term_size.ws_ypixel && term_size.ws_col && term_size.ws_row) {
+        Config.cell_width = term_size.ws_xpixel / term_size.ws_col;
+        Config.cell_height = term_size.ws_ypixel / term_size.ws_row;
+    }
+}
 
-    // Reading up to 64 bytes is safe for most escape sequences.
-    char buf[64];
-    int nread = read(STDIN_FILENO, buf, sizeof(buf) - 1);
-    if (nread <= 0)
-        return 0;
-    buf[nread] = '\0';
+static void poll_resize() {
+    if (recording.replaying) {
+        if (!replay_due(RECORD_SIZE))
+            return;
+        read_size(&recording.size);
+        replay_read_next();
+    } else if (resize_time == 0 || get_time_sec() - resize_time < RESIZE_DEBOUNCE) {
+        return;
+    }
+    resize_time = 0;
+    read_terminal_size();
+    if (recording.file && !recording.replaying) {
+        write_record(RECORD_SIZE, recording_time());
+        write_size(&term_size);
+    }
+    mark_dirty();
+}
 
-    // Simple key press handling
-    if (nread == 1) {
-        if (buf[0] == 27) { // Escape key
-            LOG("Escape key pressed, quitting...");
-            return 1; // Request quit
-        }
-        if (buf[0] == 127) {
-            LOG("Backspace key pressed");
-            mu_input_keydown(ctx, MU_KEY_BACKSPACE);
-            return 0;
+da_declare(PasteText, char);
+
+// Bytes read from stdin and not parsed yet: sequences can be split across
+// reads, and events after a key or button change wait for the next frame.
+static struct {
+    char buf[4096];
+    int len;
+    int events;      // events handled in the current frame
+    bool has_motion; // motion not yet passed to microui
+    mu_Vec2 motion;
+    double esc_time; // when a lone ESC was first seen, 0 if none
+    int release_keys; // keys to release next frame, for lack of a report
+    bool pasting;     // between the bracketed paste start and end markers
+    bool paste_cr;    // the last pasted byte was a carriage return
+    PasteText paste;  // the paste so far, passed to microui once it ends
+} pending_input = {0};
+
+// Time from reading input to writing the frame that shows it.
+static struct {
+    double input_time; // when the oldest input not on screen yet was read
+    float samples[LATENCY_SAMPLES]; // the latest ones, in seconds
+    int count;
+} latency = {0};
+
+// How long a lone ESC waits for the rest of a sequence before it counts as
+// the Escape key.
+#define ESC_TIMEOUT 0.05
+
+enum {
+    INPUT_NEXT,       // event handled, parse the next one
+    INPUT_END_FRAME,  // leave the next events to the next frame
+    INPUT_INCOMPLETE, // wait for more bytes
+    INPUT_DEFER,      // handle this event in the next frame
+    INPUT_QUIT,
+};
+
+// Passes the latest mouse motion on to microui.
+static void flush_motion(mu_Context *ctx) {
+    if (!pending_input.has_motion)
+        return;
+    pending_input.has_motion = false;
+    LOG("Mouse moved to %d,%d", pending_input.motion.x, pending_input.motion.y);
+    // Moving over the same control of the last frame, without dragging,
+    // changes nothing on screen.
+    mu_Id hit = mu_hit_test(ctx, ctx->mouse_pos);
+    mu_input_mousemove(ctx, pending_input.motion.x, pending_input.motion.y);
+    if (ctx->mouse_down || mu_hit_test(ctx, ctx->mouse_pos) != hit)
+        mark_dirty();
+}
+
+static int handle_mouse(mu_Context *ctx, int button, int x, int y, char event_type) {
+    int pixel_x, pixel_y;
+    if (!Config.width_chars) // no frame yet
+        return INPUT_NEXT;
+    if (Config.mouse_pixels) {
+        // Scale from screen pixels to the framebuffer, which is shown over
+        // width_chars x height_chars cells.
+        pixel_x = x * Config.width / (Config.width_chars * Config.cell_width);
+        pixel_y = y * Config.height / (Config.height_chars * Config.cell_height);
+    } else {
+        // Terminal coordinates are 1-based, convert to 0-based
+        // We also convert from character cell coordinates to pixel coordinates.
+        pixel_x = (x - 1) * Config.width / Config.width_chars;
+        pixel_y = (y - 1) * Config.height / Config.height_chars;
+    }
+
+    int mu_button = 0;
+    switch (button & 3) {
+    case 0:
+        mu_button = MU_MOUSE_LEFT;
+        break;
+    case 1:
+        mu_button = MU_MOUSE_MIDDLE;
+        break;
+    case 2:
+        mu_button = MU_MOUSE_RIGHT;
+        break;
+    }
+
+    // Handle motion event, reported with the held button during a drag
+    if ((button & 32) && (!mu_button || (ctx->mouse_down & mu_button))) {
+        pending_input.motion = mu_vec2(pixel_x, pixel_y);
+        pending_input.has_motion = true;
+        if (Config.motion == MOTION_ALL || (Config.motion == MOTION_DRAG && ctx->mouse_down)) {
+            flush_motion(ctx);
+            return INPUT_END_FRAME;
         }
-        if (isprint(buf[0])) {
-            LOG("Key pressed: %c", buf[0]);
-            mu_input_text(ctx, buf);
-            return 0;
+        return INPUT_NEXT;
+    }
+
+    // Handle scroll wheel
+    if ((button & 64)) {
+        flush_motion(ctx);
+        mark_dirty();
+        if (button == 64) { // wheel up
+            LOG("Mouse wheel up");
+            mu_input_scroll(ctx, 0, -FONT_SIZE);
+        } else if (button == 65) { // wheel down
+            LOG("Mouse wheel down");
+            mu_input_scroll(ctx, 0, FONT_SIZE);
+        } else if (button == 66) { // wheel left
+            LOG("Mouse wheel left");
+            mu_input_scroll(ctx, -FONT_SIZE, 0);
+        } else if (button == 67) { // wheel right
+            LOG("Mouse wheel right");
+            mu_input_scroll(ctx, FONT_SIZE, 0);
+        } else {
+            LOG("Unknown scroll event: %d", button);
         }
-        if (buf[0] == 13) {
-            LOG("Enter key pressed");
-            mu_input_keydown(ctx, MU_KEY_RETURN);
-            return 0;
+        return INPUT_NEXT;
+    }
+
+    // Handle button press/release
+    if (!mu_button)
+        return INPUT_NEXT; // Unknown button
+    mark_dirty();
+    // Let the frame see the drag that came before the release.
+    if (event_type == 'm' && pending_input.events)
+        return INPUT_DEFER;
+    flush_motion(ctx);
+    if (event_type == 'M') { // Press
+        LOG("Mouse button %d pressed at %d,%d [%d,%d]", mu_button, pixel_x,
+            pixel_y, x, y);
+        mu_input_mousedown(ctx, pixel_x, pixel_y, mu_button);
+    } else if (event_type == 'm') { // Release
+        LOG("Mouse button %d released at %d,%d [%d,%d]", mu_button, pixel_x,
+            pixel_y, x, y);
+        mu_input_mouseup(ctx, pixel_x, pixel_y, mu_button);
+    }
+    // microui sees one state per frame: a release must not hide a press.
+    return INPUT_END_FRAME;
+}
+
+// Answer to the SGR-Pixels mode query sent by enable_raw_mode(). Pixel
+// reports can't be mapped without the cell size, so they are turned off again
+// when it's unknown and the cell reports of 1006 are used.
+static void set_mouse_pixels(bool enabled) {
+    if (enabled && (!Config.cell_width || !Config.cell_height)) {
+        fprintf(term_out, "\033[?1016l");
+        fflush(term_out);
+        enabled = false;
+    }
+    LOG("SGR-Pixels mouse reports %s", enabled ? "enabled" : "unavailable");
+    Config.mouse_pixels = enabled;
+}
+
+// Keys of CSI (and SS3) sequences, by final byte: `CSI 1;mods X` in the
+// kitty protocol and legacy modes alike.
+static const int csi_letter_keys[26] = {
+    ['A' - 'A'] = MU_KEY_UP,   ['B' - 'A'] = MU_KEY_DOWN,
+    ['C' - 'A'] = MU_KEY_RIGHT, ['D' - 'A'] = MU_KEY_LEFT,
+    ['F' - 'A'] = MU_KEY_END,  ['H' - 'A'] = MU_KEY_HOME,
+};
+
+// Keys of `CSI number;mods ~` sequences, by number.
+static const int csi_tilde_keys[9] = {
+    [1] = MU_KEY_HOME,   [2] = MU_KEY_INSERT, [3] = MU_KEY_DELETE,
+    [4] = MU_KEY_END,    [5] = MU_KEY_PAGEUP, [6] = MU_KEY_PAGEDOWN,
+    [7] = MU_KEY_HOME,   [8] = MU_KEY_END,
+};
+
+// Keys of `CSI code;mods u` sequences (and of single bytes), by code point.
+static int key_from_code(int code) {
+    switch (code) {
+    case 8:
+    case 127:
+        return MU_KEY_BACKSPACE;
+    case 9:
+        return MU_KEY_TAB;
+    case 13:
+        return MU_KEY_RETURN;
+    case 27:
+        return MU_KEY_ESCAPE;
+    }
+    return 0;
+}
+
+// Passes a key event to microui. `mods` is the modifier parameter of the
+// sequence, 1 + shift(1) + alt(2) + ctrl(4); `event` is 1 for a press, 2 for
+// a repeat and 3 for a release, or 0 for a press in a legacy encoding. Keys
+// without a release report are released at the start of the next frame.
+static int handle_key(mu_Context *ctx, int key, int mods, int event) {
+    mods = mods > 0 ? mods - 1 : 0;
+    if (mods & 1)
+        key |= MU_KEY_SHIFT;
+    if (mods & 2)
+        key |= MU_KEY_ALT;
+    if (mods & 4)
+        key |= MU_KEY_CTRL;
+    mark_dirty();
+    if (event == 3) {
+        // Modifiers alone aren't reported: release them with the key.
+        LOG("Key released: %#x", key);
+        mu_input_keyup(ctx, key | MU_KEY_SHIFT | MU_KEY_CTRL | MU_KEY_ALT);
+        return INPUT_NEXT;
+    }
+    LOG("Key pressed: %#x", key);
+    mu_input_keydown(ctx, key);
+    if (event == 0 || !Config.key_releases)
+        pending_input.release_keys |= key;
+    // microui sees one state per frame: a repeat must not hide a press.
+    return INPUT_END_FRAME;
+}
+
+// Decodes `CSI params final` as a key, with params `number[:alternates]`,
+// `mods[:event]` and `text` as in the kitty protocol. Returns -1 if it isn't
+// a key.
+static int parse_key_sequence(mu_Context *ctx, const char *params, int len, char final) {
+    // number[:alternates] ; mods[:event] ; text, each value defaulting to 1.
+    int fields[2][2] = {{1, 0}, {1, 1}};
+    int field = 0, sub = 0;
+    bool digits = false;
+    for (int i = 0; i < len; i++) {
+        char c = params[i];
+        if (c >= '0' && c <= '9') {
+            if (field < 2 && sub < 2) {
+                if (!digits)
+                    fields[field][sub] = 0;
+                fields[field][sub] = fields[field][sub] * 10 + (c - '0');
+            }
+            digits = true;
+        } else if (c == ';' || c == ':') {
+            field += c == ';';
+            sub = c == ';' ? 0 : sub + 1;
+            digits = false;
+        } else {
+            return -1; // private or intermediate bytes: not a key
         }
-        if (buf[0] == 3) {
+    }
+    int number = fields[0][0], mods = fields[1][0], event = fields[1][1];
+
+    int key = 0;
+    if (final >= 'A' && final <= 'Z')
+        key = csi_letter_keys[final - 'A'];
+    else if (final == '~')
+        key = number < 9 ? csi_tilde_keys[number] : 0;
+    else if (final == 'u')
+        key = key_from_code(number);
+    else
+        return -1;
+
+    if (final == 'u' && !key) {
+        // Ctrl+C is the quit shortcut; other text keys arrive as text.
+        if ((number == 'c' || number == 'C') && mods > 0 && ((mods - 1) & 4) && event != 3) {
             LOG("Ctrl+C pressed, quitting...");
-            return 1; // Request quit
+            return INPUT_QUIT;
         }
-        LOG("Non-printable key pressed: %d", buf[0]);
-        return 0;
+        return INPUT_NEXT;
     }
+    if (!key) // function keys and such
+        return INPUT_NEXT;
+    return handle_key(ctx, key, mods, event);
+}
 
-    // Mouse event parsing (SGR format: \033[<BTN;X;Ym or \033[<BTN;X;YM)
-    if (nread > 5 && strncmp(buf, "\033[<", 3) == 0) {
+// Parses the escape sequence at the start of `p`, which begins with ESC.
+static int parse_escape(mu_Context *ctx, const char *p, int len, int *used) {
+    if (len == 1) {
+        double now = recording.file ? recording.time : get_time_sec();
+        if (!pending_input.esc_time)
+            pending_input.esc_time = now;
+        if (now - pending_input.esc_time < ESC_TIMEOUT)
+            return INPUT_INCOMPLETE;
+        pending_input.esc_time = 0;
+        *used = 1;
+        return handle_key(ctx, MU_KEY_ESCAPE, 1, 0);
+    }
+    pending_input.esc_time = 0;
+
+    if (p[1] == '[') { // CSI: parameters and intermediates, then a final byte
+        int i = 2;
+        while (i < len && p[i] >= 0x20 && p[i] <= 0x3f)
+            i++;
+        if (i == len)
+            return INPUT_INCOMPLETE;
+        if (p[i] < 0x40 || p[i] > 0x7e) { // cut short by another sequence
+            *used = i;
+            return INPUT_NEXT;
+        }
+        *used = i + 1;
+        // Mouse event parsing (SGR format: \033[<BTN;X;Ym or \033[<BTN;X;YM)
         int button, x, y;
         char event_type;
+        if (p[2] == '<' && (p[i] == 'M' || p[i] == 'm') &&
+            sscanf(p, "\033[<%d;%d;%d%c", &button, &x, &y, &event_type) == 4) {
+            int result = handle_mouse(ctx, button, x, y, event_type);
+            if (result == INPUT_DEFER) {
+                *used = 0;
+                return INPUT_END_FRAME;
+            }
+            return result;
+        }
+        int mode, state, height, width;
+        if (p[i] == 'y' && sscanf(p, "\033[?%d;%d$y", &mode, &state) == 2 && mode == 1016) {
+            set_mouse_pixels(state == 1 || state == 3);
+            return INPUT_NEXT;
+        }
+        if (p[i] == '~' && i == 5 && !strncmp(p + 2, "200", 3)) {
+            pending_input.pasting = true;
+            return INPUT_NEXT;
+        }
+        int flags;
+        if (p[i] == 'u' && sscanf(p, "\033[?%du", &flags) == 1) {
+            LOG("Keyboard protocol flags %d", flags);
+            Config.key_releases = flags & 2;
+            return INPUT_NEXT;
+        }
+        if (p[i] == 't' && sscanf(p, "\033[6;%d;%dt", &height, &width) == 2) {
+            LOG("Cell size %dx%d", width, height);
+            Config.cell_width = width;
+            Config.cell_height = height;
+            mark_dirty(); // resize the framebuffer to it
+            return INPUT_NEXT;
+        }
+        int result = parse_key_sequence(ctx, p + 2, i - 2, p[i]);
+        if (result >= 0)
+            return result;
+        mark_dirty();
+        LOG("Unrecognized sequence: CSI %.*s", i - 1, p + 2);
+        return INPUT_NEXT;
+    }
+    if (p[1] == '_' || p[1] == 'P' || p[1] == ']') { // strings up to ST or BEL
+        for (int i = 2; i < len; i++) {
+            if (p[i] == '\a' || (p[i] == '\\' && p[i - 1] == 27)) {
+                *used = i + 1;
+                return INPUT_NEXT;
+            }
+        }
+        return INPUT_INCOMPLETE;
+    }
+    if (p[1] == 'O') { // SS3: cursor keys in application mode
+        if (len < 3)
+            return INPUT_INCOMPLETE;
+        *used = 3;
+        if (p[2] >= 'A' && p[2] <= 'Z' && csi_letter_keys[p[2] - 'A'])
+            return handle_key(ctx, csi_letter_keys[p[2] - 'A'], 1, 0);
+        return INPUT_NEXT;
+    }
+    *used = 2;
+    LOG("Unrecognized input: ESC %d", p[1]);
+    return INPUT_NEXT;
+}
 
-        if (sscanf(buf, "\033[<%d;%d;%d%c", &button, &x, &y, &event_type) == 4) {
-            // Terminal coordinates are 1-based, convert to 0-based
-            // We also convert from character cell coordinates to pixel coordinates.
-            int pixel_x = (x - 1) * Config.width / Config.width_chars;
-            int pixel_y = (y - 1) * Config.height / Config.height_chars;
+// Returns the length of the UTF-8 sequence starting with `lead`, 0 when it
+// can't start one.
+static int utf8_sequence_length(uint8_t lead) {
+    if (lead < 0x80)
+        return 1;
+    if (lead >= 0xc2 && lead <= 0xdf)
+        return 2;
+    if (lead >= 0xe0 && lead <= 0xef)
+        return 3;
+    if (lead >= 0xf0 && lead <= 0xf4)
+        return 4;
+    return 0;
+}
 
-            // Handle motion event
-            if ((button & 32)) {
-                LOG("Mouse moved to %d,%d [%d,%d]", pixel_x, pixel_y, x, y);
-                mu_input_mousemove(ctx, pixel_x, pixel_y);
-            }
+// Decodes the code point at the start of `str` and returns the bytes it used.
+// Invalid sequences decode as U+FFFD one byte at a time; the continuation
+// bytes left behind are skipped by callers, as they are by utf8_count().
+static int utf8_decode(const char *str, int len, uint32_t *cp) {
+    const uint8_t *s = (const uint8_t *)str;
+    int n = utf8_sequence_length(s[0]);
+    *cp = n == 1 ? s[0] : 0xfffd;
+    if (n <= 1 || n > len)
+        return 1;
+    uint32_t c = s[0] & (0x7f >> n);
+    for (int i = 1; i < n; i++) {
+        if ((s[i] & 0xc0) != 0x80)
+            return 1;
+        c = (c << 6) | (s[i] & 0x3f);
+    }
+    if ((n == 3 && c < 0x800) || (n == 4 && (c < 0x10000 || c > 0x10ffff)) ||
+        (c >= 0xd800 && c <= 0xdfff))
+        return 1; // overlong, out of range or a surrogate
+    *cp = c;
+    return n;
+}
 
-            // Handle scroll wheel
-            if ((button & 64)) {
-                if (button == 64) { // wheel up
-                    LOG("Mouse wheel up");
-                    mu_input_scroll(ctx, 0, -FONT_SIZE);
-                } else if (button == 65) { // wheel down
-                    LOG("Mouse wheel down");
-                    mu_input_scroll(ctx, 0, FONT_SIZE);
-                } else if (button == 66) { // wheel left
-                    LOG("Mouse wheel left");
-                    mu_input_scroll(ctx, -FONT_SIZE, 0);
-                } else if (button == 67) { // wheel right
-                    LOG("Mouse wheel right");
-                    mu_input_scroll(ctx, FONT_SIZE, 0);
-                } else {
-                    LOG("Unknown scroll event: %d", button);
-                }
-            } else { // Handle button press/release
-                int mu_button = 0;
-                switch (button & 3) {
-                case 0:
-                    mu_button = MU_MOUSE_LEFT;
-                    break;
-                case 1:
-                    mu_button = MU_MOUSE_MIDDLE;
-                    break;
-                case 2:
-                    mu_button = MU_MOUSE_RIGHT;
-                    break;
-                default:
-                    return 0; // Unknown button
-                }
+// Counts the characters in the first `len` bytes of `str`.
+static int utf8_count(const char *str, int len) {
+    int count = 0;
+    for (int i = 0; i < len && str[i]; i++)
+        count += (str[i] & 0xc0) != 0x80;
+    return count;
+}
 
-                if (event_type == 'M') { // Press
-                    LOG("Mouse button %d pressed at %d,%d [%d,%d]", mu_button, pixel_x,
-                        pixel_y, x, y);
-                    mu_input_mousedown(ctx, pixel_x, pixel_y, mu_button);
-                } else if (event_type == 'm') { // Release
-                    LOG("Mouse button %d released at %d,%d [%d,%d]", mu_button, pixel_x,
-                        pixel_y, x, y);
-                    mu_input_mouseup(ctx, pixel_x, pixel_y, mu_button);
-                }
-            }
+// Adds the UTF-8 encoded character at the start of `p` to the text input.
+static int parse_utf8_text(mu_Context *ctx, const char *p, int len, int *used) {
+    int n = utf8_sequence_length(p[0]);
+    if (n > len) {
+        int i = 1;
+        while (i < len && (p[i] & 0xc0) == 0x80)
+            i++;
+        if (i == len)
+            return INPUT_INCOMPLETE;
+    }
+    uint32_t cp;
+    *used = utf8_decode(p, len, &cp);
+    if (*used == 1) {
+        // also skips stray continuation bytes
+        LOG("Invalid UTF-8 byte: %d", (uint8_t)p[0]);
+        return INPUT_NEXT;
+    }
+    mark_dirty();
+    LOG("Key pressed: U+%04X", cp);
+    char text[5] = {0};
+    memcpy(text, p, n);
+    mu_input_text(ctx, text);
+    return INPUT_NEXT;
+}
+
+#define PASTE_END "\033[201~"
+
+// Collects pasted bytes up to the bracketed paste end marker, then passes the
+// whole paste to microui as the text input of a single frame. Line breaks
+// become '\n' and other control characters are dropped.
+static int parse_paste(mu_Context *ctx, const char *p, int len, int *used) {
+    int end_len = sizeof(PASTE_END) - 1;
+    int i = 0;
+    for (; i < len; i++) {
+        if (p[i] == 27) {
+            int n = len - i < end_len ? len - i : end_len;
+            if (memcmp(p + i, PASTE_END, n) == 0)
+                break;
+            continue;
         }
-        return 0;
+        bool cr = p[i] == '\r';
+        if (cr || (p[i] == '\n' && !pending_input.paste_cr))
+            da_append(&pending_input.paste, '\n');
+        else if (((uint8_t)p[i] >= 0x20 && p[i] != 0x7f) || p[i] == '\t')
+            da_append(&pending_input.paste, p[i]);
+        pending_input.paste_cr = cr;
     }
+    *used = i;
+    if (len - i < end_len)
+        return INPUT_INCOMPLETE; // the end marker, or the rest of it, is still to come
+    *used += end_len;
+    da_append(&pending_input.paste, '\0');
+    LOG("Pasted %zu bytes", pending_input.paste.count - 1);
+    mu_input_text(ctx, pending_input.paste.items);
+    pending_input.paste.count = 0;
+    pending_input.pasting = pending_input.paste_cr = false;
+    mark_dirty();
+    return INPUT_NEXT;
+}
 
-    LOG("Unrecognized input: %d - %d", nread, buf[0]);
-    return 0;
+// Parses the event at the start of `p`, setting the bytes it used.
+static int parse_input_event(mu_Context *ctx, const char *p, int len, int *used) {
+    if (pending_input.pasting)
+        return parse_paste(ctx, p, len, used);
+    if (p[0] == 27)
+        return parse_escape(ctx, p, len, used);
+    if ((uint8_t)p[0] >= 0x80)
+        return parse_utf8_text(ctx, p, len, used);
+
+    // Simple key press handling
+    *used = 1;
+    mark_dirty();
+    int key = key_from_code(p[0]);
+    if (key)
+        return handle_key(ctx, key, 1, 0);
+    if (isprint((unsigned char)p[0])) {
+        LOG("Key pressed: %c", p[0]);
+        char text[2] = {p[0], '\0'};
+        mu_input_text(ctx, text);
+        return INPUT_NEXT;
+    }
+    if (p[0] == 3) {
+        LOG("Ctrl+C pressed, quitting...");
+        return INPUT_QUIT;
+    }
+    LOG("Non-printable key pressed: %d", p[0]);
+    return INPUT_NEXT;
+}
+
+// Appends everything pending on stdin to the input buffer, or the next input
+// of the replay, and returns the bytes added. Reads, and calls waiting for the
+// rest of an ESC, are recorded with the time the parser uses.
+static int read_input() {
+    int start = pending_input.len;
+    int space = sizeof(pending_input.buf) - start;
+    if (recording.replaying) {
+        // Frames the recording rendered next, and the replay won't as it's
+        // idle.
+        while (recording.next == RECORD_FRAME && dirty_frames == 0) {
+            read_u32();
+            recording.mismatches++;
+            replay_read_next();
+        }
+        if (!replay_due(RECORD_INPUT))
+            return 0;
+        int len = read_u16();
+        int nread = fread(pending_input.buf + start, 1, len < space ? len : space, recording.file);
+        if (len > space)
+            fseek(recording.file, len - space, SEEK_CUR);
+        pending_input.len += nread;
+        recording.time = recording.next_time / 1000000.0;
+        replay_read_next();
+        return nread;
+    }
+
+    bool waiting_escape = pending_input.esc_time != 0;
+    int bytes_waiting;
+    while ((bytes_waiting = kbhit()) > 0 && pending_input.len < (int)sizeof(pending_input.buf)) {
+        space = sizeof(pending_input.buf) - pending_input.len;
+        int nread = read(STDIN_FILENO, pending_input.buf + pending_input.len,
+                         bytes_waiting < space ? bytes_waiting : space);
+        if (nread <= 0)
+            break;
+        pending_input.len += nread;
+    }
+    int received = pending_input.len - start;
+    if (received && !latency.input_time)
+        latency.input_time = get_time_sec();
+    if (recording.file && (received || waiting_escape)) {
+        recording.time = recording_time();
+        write_record(RECORD_INPUT, recording.time);
+        write_u16(received);
+        fwrite(pending_input.buf + start, 1, received, recording.file);
+    }
+    return received;
+}
+
+// Parses the buffered input up to the first event that has to wait for more
+// bytes or the next frame, and returns how that event was handled.
+static int parse_pending_input(mu_Context *ctx) {
+    int pos = 0, result = INPUT_NEXT;
+    while (pos < pending_input.len && result == INPUT_NEXT) {
+        int used = 0;
+        result = parse_input_event(ctx, pending_input.buf + pos, pending_input.len - pos, &used);
+        pos += used;
+        pending_input.events++;
+    }
+    // A sequence that can't complete in a full buffer is garbage.
+    if (result == INPUT_INCOMPLETE && pos == 0 && pending_input.len == (int)sizeof(pending_input.buf))
+        pos = pending_input.len;
+    memmove(pending_input.buf, pending_input.buf + pos, pending_input.len - pos);
+    pending_input.len -= pos;
+    return result;
+}
+
+// Reads everything pending on stdin and feeds the events to microui in order,
+// up to the first one that has to wait for the next frame.
+int process_input(mu_Context *ctx) {
+    read_input();
+
+    if (pending_input.release_keys) {
+        mu_input_keyup(ctx, pending_input.release_keys);
+        pending_input.release_keys = 0;
+    }
+
+    int result;
+    pending_input.events = 0;
+    // A paste can be far larger than the buffer: keep reading it while the
+    // terminal has more, instead of taking a frame per buffer.
+    do {
+        result = parse_pending_input(ctx);
+    } while (result == INPUT_INCOMPLETE && pending_input.pasting && read_input());
+    flush_motion(ctx);
+    if (recording.replaying && !recording.next && !pending_input.len)
+        return 1; // end of the replay
+    return result == INPUT_QUIT;
 }
 
 void crt_set_pixel(int x, int y, uint32_t color) {
@@ -386,21 +1277,77 @@ uint32_t toColor(mu_Color color) {
 }
 
 void draw_rectangle(int x, int y, int w, int h, uint32_t color) {
-    for (int i = 0; i < h; i++) {
-        for (int j = 0; j < w; j++) {
-            crt_set_pixel(x + j, y + i, color);
+    // Clip the rectangle once instead of testing every pixel.
+    int x1 = x > 0 ? x : 0, y1 = y > 0 ? y : 0;
+    int x2 = x + w < Config.width ? x + w : Config.width;
+    int y2 = y + h < Config.height ? y + h : Config.height;
+    if (clip_rect.enabled) {
+        if (x1 < clip_rect.x) x1 = clip_rect.x;
+        if (y1 < clip_rect.y) y1 = clip_rect.y;
+        if (x2 > clip_rect.x + clip_rect.w) x2 = clip_rect.x + clip_rect.w;
+        if (y2 > clip_rect.y + clip_rect.h) y2 = clip_rect.y + clip_rect.h;
+    }
+    uint8_t r = (color >> 16) & 0xff, g = (color >> 8) & 0xff, b = color & 0xff;
+    for (int i = y1; i < y2; i++) {
+        uint8_t *dst = fb + (x1 + i * Config.width) * 3;
+        for (int j = x1; j < x2; j++) {
+            *dst++ = r;
+            *dst++ = g;
+            *dst++ = b;
         }
     }
 }
 
-void draw_char(int x, int y, char c, uint32_t color) {
-    uint8_t ch = (uint8_t)c;
+// Glyphs beyond ASCII are looked up in font_8x8_ext the first time they are
+// drawn and cached in pages of 256 code points, allocated on first use, so
+// drawing stays a table lookup per character.
+struct glyph_page {
+    uint8_t glyphs[256][8];
+    uint8_t loaded[256 / 8];
+};
+static struct glyph_page *glyph_pages[0x10000 >> 8];
+
+static const uint8_t *find_ext_glyph(uint32_t cp) {
+    int lo = 0, hi = sizeof(font_8x8_ext) / sizeof(font_8x8_ext[0]) - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (font_8x8_ext[mid].code == cp)
+            return font_8x8_ext[mid].glyph;
+        if (font_8x8_ext[mid].code < cp)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return NULL;
+}
 
-    if (ch > 126)
-        ch = 32; // Replace invalid chars with space
+static const uint8_t *get_glyph(uint32_t cp) {
+    if (cp < 127)
+        return font_8x8[cp];
+    if (cp < 0xa0)
+        return font_8x8[' ']; // DEL and C1 controls
+    if (cp >= 0x10000)
+        cp = 0xfffd;
+    struct glyph_page **page = &glyph_pages[cp >> 8];
+    if (!*page && !(*page = calloc(1, sizeof(**page))))
+        return font_8x8[' '];
+    int i = cp & 0xff;
+    if (!((*page)->loaded[i / 8] & (1 << (i % 8)))) {
+        const uint8_t *glyph = find_ext_glyph(cp);
+        memcpy((*page)->glyphs[i], glyph ? glyph : find_ext_glyph(0xfffd), 8);
+        (*page)->loaded[i / 8] |= 1 << (i % 8);
+    }
+    return (*page)->glyphs[i];
+}
 
-    const uint8_t *glyph = font_8x8[ch];
+static void free_glyph_pages(void) {
+    for (size_t i = 0; i < sizeof(glyph_pages) / sizeof(glyph_pages[0]); i++) {
+        free(glyph_pages[i]);
+        glyph_pages[i] = NULL;
+    }
+}
 
+void draw_glyph(int x, int y, const uint8_t *glyph, uint32_t color) {
     for (int row = 0; row < 8; row++) {
         uint8_t line = glyph[row];
         for (int col = 0; col < 8; col++) {
@@ -421,18 +1368,23 @@ void draw_text(int x, int y, char *str, uint32_t color) {
         if (*str == '\n') {
             current_x = x;
             current_y += char_height;
+            str++;
+        } else if ((*str & 0xc0) == 0x80) {
+            str++; // left over from an invalid sequence
         } else {
-            draw_char(current_x, current_y, *str, color);
+            uint32_t cp;
+            // the terminating NUL stops a truncated sequence, so no length is needed
+            str += utf8_decode(str, 4, &cp);
+            draw_glyph(current_x, current_y, get_glyph(cp), color);
             current_x += char_width;
         }
-        str++;
     }
 }
 
 void draw_icon(int id, mu_Rect rect, mu_Color color) {
     int x = rect.x + (rect.w - 8) / 2;
     int y = rect.y + (rect.h - 8) / 2;
-    draw_char(x, y, id, toColor(color));
+    draw_glyph(x, y, font_8x8[id], toColor(color));
 }
 
 void draw_image(unsigned char *data, int n, int x, int y, int w, int h) {
@@ -461,26 +1413,20 @@ void draw_image(unsigned char *data, int n, int x, int y, int w, int h) {
     }
 }
 
-void set_clip_rect(int x, int y, int w, int h) {
-    if (w == 0x1000000 && h == 0x1000000) {
-        clip_rect.enabled = false;
-    } else {
-        clip_rect.x = x;
-        clip_rect.y = y;
-        clip_rect.w = w;
-        clip_rect.h = h;
-        clip_rect.enabled = true;
-    }
-}
-
 void updateWindowSize(int width, int height) {
-    if (fb && width == Config.width_chars && height == Config.height_chars) {
+    // Render at the terminal's resolution when the cell size is known, so it
+    // doesn't have to scale the image, less the downscale factor.
+    int scale = Config.downscale > 1 ? Config.downscale : 1;
+    int pixel_width = Config.cell_width ? width * Config.cell_width / scale : width * RESW;
+    int pixel_height = Config.cell_height ? height * Config.cell_height / scale : height * RESH;
+    if (fb && width == Config.width_chars && height == Config.height_chars &&
+        pixel_width == Config.width && pixel_height == Config.height) {
         return;
     }
     Config.width_chars = width;
     Config.height_chars = height;
-    Config.width = (width * RESW);
-    Config.height = (height * RESH);
+    Config.width = pixel_width;
+    Config.height = pixel_height;
     size_t fb_size = Config.width * Config.height * 3;
     if (fb) {
         fb = realloc(fb, fb_size);
@@ -489,8 +1435,8 @@ void updateWindowSize(int width, int height) {
         root->rect.w = 0;
         if (Config.kitty_mode) {
             // Clear the screen in Kitty mode
-            printf("\033[3J\033[H");
-            fflush(stdout);
+            fprintf(term_out, "\033[3J\033[H");
+            fflush(term_out);
         }
     } else {
         fb = malloc(fb_size);
@@ -502,17 +1448,174 @@ void updateWindowSize(int width, int height) {
 int getTextWidth(mu_Font font, const char *str, int len) {
     if (len < 0)
         len = strlen(str);
-    return len * FONT_SIZE;
+    return utf8_count(str, len) * FONT_SIZE;
 }
 
 int getTextHeight(mu_Font font) { return FONT_SIZE; }
 
+void data_table_clear_columns(struct data_table *table) {
+    for (int c = 0; c < table->column_count; c++) {
+        struct table_column *col = &table->columns[c];
+        if (col->strings) {
+            for (int r = 0; r < table->row_count; r++)
+                free(col->strings[r]);
+        }
+        free(col->strings);
+        free(col->numbers);
+        free(col->title);
+    }
+    free(table->columns);
+    table->columns = NULL;
+    table->column_count = 0;
+    table->row_count = 0;
+    table->row_capacity = 0;
+}
+
+void data_table_free(struct data_table *table) {
+    if (!table)
+        return;
+    data_table_clear_columns(table);
+    free(table->order);
+    free(table);
+}
+
+struct data_table *widget_slot_table(struct widget_slot *slot) {
+    if (!slot->table) {
+        slot->table = calloc(1, sizeof(*slot->table));
+        slot->table->sort_column = -1;
+    }
+    return slot->table;
+}
+
+const char *table_cell_text(struct table_column *col, int row, char *buf, size_t size) {
+    if (col->numeric) {
+        snprintf(buf, size, "%.12g", col->numbers[row]);
+        return buf;
+    }
+    return col->strings[row] ? col->strings[row] : "";
+}
+
+void table_column_fit(struct table_column *col, const char *text) {
+    int width = getTextWidth(NULL, text, -1);
+    if (width > col->width)
+        col->width = width;
+}
+
+void data_table_set_columns(struct data_table *table, int count, char **titles) {
+    if (count == table->column_count) {
+        // Only the titles changed: keep the cells and their widths.
+        for (int c = 0; c < count; c++) {
+            struct table_column *col = &table->columns[c];
+            free(col->title);
+            col->title = titles[c];
+            int width = getTextWidth(NULL, titles[c], -1) + FONT_SIZE * 2;
+            if (width > col->width)
+                col->width = width;
+        }
+        return;
+    }
+    data_table_clear_columns(table);
+    table->columns = calloc(count, sizeof(struct table_column));
+    table->column_count = count;
+    for (int c = 0; c < count; c++) {
+        table->columns[c].title = titles[c];
+        // Leave room for the sort indicator next to the title.
+        table->columns[c].width = getTextWidth(NULL, titles[c], -1) + FONT_SIZE * 2;
+    }
+    if (table->sort_column >= count)
+        table->sort_column = -1;
+    table->order_dirty = true;
+}
+
+void data_table_set_row_count(struct data_table *table, int rows) {
+    if (rows == table->row_count)
+        return;
+    if (rows > table->row_capacity) {
+        int capacity = table->row_capacity ? table->row_capacity : 64;
+        while (capacity < rows)
+            capacity *= 2;
+        for (int c = 0; c < table->column_count; c++) {
+            struct table_column *col = &table->columns[c];
+            col->numbers = realloc(col->numbers, capacity * sizeof(double));
+            col->strings = realloc(col->strings, capacity * sizeof(char *));
+        }
+        table->order = realloc(table->order, capacity * sizeof(int));
+        table->row_capacity = capacity;
+    }
+    for (int c = 0; c < table->column_count; c++) {
+        struct table_column *col = &table->columns[c];
+        for (int r = rows; r < table->row_count; r++)
+            free(col->strings[r]);
+        for (int r = table->row_count; r < rows; r++) {
+            col->numbers[r] = 0;
+            col->strings[r] = NULL;
+        }
+    }
+    table->row_count = rows;
+    table->order_dirty = true;
+}
+
+static struct data_table *sort_table;
+
+static int compare_table_rows(const void *a, const void *b) {
+    struct table_column *col = &sort_table->columns[sort_table->sort_column];
+    int ra = *(const int *)a, rb = *(const int *)b;
+    int cmp;
+    if (col->numeric) {
+        cmp = (col->numbers[ra] > col->numbers[rb]) - (col->numbers[ra] < col->numbers[rb]);
+    } else {
+        cmp = strcmp(col->strings[ra] ? col->strings[ra] : "",
+                     col->strings[rb] ? col->strings[rb] : "");
+    }
+    if (cmp)
+        return sort_table->sort_desc ? -cmp : cmp;
+    return ra - rb; // keep equal rows in data order
+}
+
+void data_table_sort(struct data_table *table) {
+    for (int r = 0; r < table->row_count; r++)
+        table->order[r] = r;
+    if (table->sort_column >= 0) {
+        sort_table = table;
+        qsort(table->order, table->row_count, sizeof(int), compare_table_rows);
+    }
+    table->order_dirty = false;
+}
+
+// Passes a label hash precomputed by hash() on to the next widget id, so
+// microui doesn't hash the label again. Ignored if the argument is missing.
+static void set_next_hash(napi_env env, napi_value *args, size_t argc, size_t index) {
+    napi_valuetype type;
+    uint32_t hash;
+    if (argc <= index || napi_typeof(env, args[index], &type) != napi_ok || type != napi_number)
+        return;
+    napi_get_value_uint32(env, args[index], &hash);
+    mu_set_next_hash(&ctx, hash);
+}
+
+napi_value muHash(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    char text[MAX_STR_LEN] = "";
+    node_get_string(0, text);
+
+    napi_value result;
+    napi_create_uint32(env, mu_hash(text, strlen(text)), &result);
+    return result;
+}
+
 napi_value muButton(napi_env env, napi_callback_info info) {
     node_parse_args();
     char text[MAX_STR_LEN];
     node_get_string(0, text);
+    struct widget_slot *slot = argc > 1 ? get_widget_slot(env, args[1]) : NULL;
 
+    // Scope the label id by the slot so equal labels don't share focus/hover.
+    if (slot)
+        mu_push_id(&ctx, &slot, sizeof(slot));
+    set_next_hash(env, args, argc, 2);
     bool result = mu_button(&ctx, text);
+    if (slot)
+        mu_pop_id(&ctx);
     return node_bool_to_napi_val(result);
 }
 
@@ -532,10 +1635,14 @@ napi_value muSlider(napi_env env, napi_callback_info info) {
     napi_get_value_int32(env, args[0], &min);
     napi_get_value_int32(env, args[1], &max);
     napi_get_value_double(env, args[2], &value);
-
-    float float_value = (float)value;
-    mu_slider(&ctx, &float_value, min, max);
-    return node_float_to_napi_val(float_value);
+    struct widget_slot *slot = argc > 3 ? get_widget_slot(env, args[3]) : NULL;
+
+    // microui derives the slider id from the value address.
+    mu_Real local_value;
+    mu_Real *float_value = slot ? &slot->value : &local_value;
+    *float_value = (mu_Real)value;
+    mu_slider(&ctx, float_value, min, max);
+    return node_float_to_napi_val(*float_value);
 }
 
 napi_value muCheckbox(napi_env env, napi_callback_info info) {
@@ -544,25 +1651,36 @@ napi_value muCheckbox(napi_env env, napi_callback_info info) {
     char text[MAX_STR_LEN];
     napi_get_value_bool(env, args[0], &checked);
     node_get_string(1, text);
-
-    int int_checked = checked;
-    mu_checkbox(&ctx, text, &int_checked);
-    return node_bool_to_napi_val(int_checked);
+    struct widget_slot *slot = argc > 2 ? get_widget_slot(env, args[2]) : NULL;
+
+    // microui derives the checkbox id from the state address.
+    int local_checked;
+    int *int_checked = slot ? &slot->checked : &local_checked;
+    *int_checked = checked;
+    mu_checkbox(&ctx, text, int_checked);
+    return node_bool_to_napi_val(*int_checked);
 }
 
 napi_value muTextbox(napi_env env, napi_callback_info info) {
     node_parse_args();
-    int id;
-    napi_get_value_int32(env, args[0], &id);
-    if (id < 0) id = 0;
-    if (id >= MAX_INPUT_IDS) id = id % MAX_INPUT_IDS;
-    static char text[MAX_INPUT_IDS][MAX_STR_LEN];
-    node_get_string(1, text[id]);
-
-    int submit = mu_textbox(&ctx, text[id], sizeof(text[id])) & MU_RES_SUBMIT;
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot)
+        return NULL;
+
+    // Make room for the current value plus this frame's text input.
+    size_t len = 0;
+    if (napi_get_value_string_utf8(env, args[1], NULL, 0, &len) != napi_ok)
+        len = 0;
+    widget_slot_reserve(slot, len + strlen(ctx.input_text) + 1);
+    if (napi_get_value_string_utf8(env, args[1], slot->text, slot->text_cap, NULL) != napi_ok)
+        slot->text[0] = '\0';
+
+    mu_Id id = mu_get_id(&ctx, &slot, sizeof(slot));
+    mu_Rect r = mu_layout_next(&ctx);
+    int submit = mu_textbox_raw(&ctx, slot->text, slot->text_cap, id, r, 0) & MU_RES_SUBMIT;
     napi_value result, text_val, submit_val;
     napi_create_object(env, &result);
-    napi_create_string_utf8(env, text[id], NAPI_AUTO_LENGTH, &text_val);
+    napi_create_string_utf8(env, slot->text, NAPI_AUTO_LENGTH, &text_val);
     napi_get_boolean(env, submit != 0, &submit_val);
     napi_set_named_property(env, result, "text", text_val);
     napi_set_named_property(env, result, "submit", submit_val);
@@ -607,8 +1725,10 @@ napi_value muBeginWindow(napi_env env, napi_callback_info info) {
         napi_get_value_int32(env, args[3], &width);
         napi_get_value_int32(env, args[4], &height);
         opt = MU_OPT_HOLDFOCUS;
+        set_next_hash(env, args, argc, 5);
         modalCnt = mu_get_container(&ctx, name);
         mu_bring_to_front(&ctx, modalCnt);
+        set_next_hash(env, args, argc, 5);
     }
 
     int ret =
@@ -630,8 +1750,23 @@ napi_value muLayoutRow(napi_env env, napi_callback_info info) {
     node_parse_args();
     int height = 0, items = 0;
     int *widths = NULL;
+    bool is_typedarray = false;
     if (argc)
         napi_get_value_int32(env, args[0], &height);
+    if (argc == 2)
+        napi_is_typedarray(env, args[1], &is_typedarray);
+    if (is_typedarray) {
+        // Widths prebuilt by the render plan as an Int32Array: microui copies
+        // them into the layout, so they can be used in place.
+        napi_typedarray_type type;
+        size_t length;
+        void *data;
+        napi_get_typedarray_info(env, args[1], &type, &length, &data, NULL, NULL);
+        if (type == napi_int32_array) {
+            mu_layout_row(&ctx, length, length ? data : NULL, height);
+            return NULL;
+        }
+    }
     if (argc > 1) {
         items = argc - 1;
         widths = malloc(items * sizeof(int));
@@ -656,24 +1791,33 @@ napi_value muEndColumn(napi_env env, napi_callback_info info) {
     return NULL;
 }
 
-double get_time_sec() {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return tv.tv_sec + (tv.tv_usec / 1000000.0);
+static double last_frame_ts = 0.0;
+
+// Sleeps until `deadline`, noting when input arrives meanwhile for the
+// latency stats.
+static void sleep_until(double deadline) {
+    double now = get_time_sec();
+    if (!latency.input_time && !recording.replaying && now < deadline) {
+        struct pollfd fd = {.fd = STDIN_FILENO, .events = POLLIN};
+        if (poll(&fd, 1, (int)((deadline - now) * 1000)) > 0)
+            latency.input_time = get_time_sec();
+        now = get_time_sec();
+    }
+    if (now < deadline)
+        usleep((useconds_t)((deadline - now) * 1000000.0));
 }
 
 void limit_fps() {
-    static double last_frame_ts = 0.0;
     static double last_fps_ts = 0.0;
     static uint32_t frame_count = 0;
 
     double current_time = get_time_sec();
     double elapsed_frame = current_time - last_frame_ts;
 
-    // cap fps
-    if (last_frame_ts && elapsed_frame < FRAME_TIME) {
-        useconds_t u = (useconds_t)((FRAME_TIME - elapsed_frame) * 1000000.0);
-        usleep(u);
+    // cap fps; in low latency mode the next frame waits instead, if it comes
+    // too soon, see pace_frame()
+    if (!Config.low_latency && last_frame_ts && elapsed_frame < Config.frame_time) {
+        sleep_until(last_frame_ts + Config.frame_time);
         current_time = get_time_sec();
     }
 
@@ -689,7 +1833,276 @@ void limit_fps() {
     last_frame_ts = current_time;
 }
 
+// Low latency mode: frames start as soon as input arrives, as long as the
+// previous one is a frame interval old.
+static void pace_frame() {
+    if (last_frame_ts)
+        sleep_until(last_frame_ts + Config.frame_time);
+}
+
+static void sample_latency(bool shown) {
+    if (!latency.input_time)
+        return;
+    if (shown) {
+        latency.samples[latency.count % LATENCY_SAMPLES] = get_time_sec() - latency.input_time;
+        latency.count++;
+    }
+    latency.input_time = 0;
+}
+
+/* Damage tracking: the draw commands of each frame are flattened with the
+ * clip rect in effect and compared to the previous frame's. Only the regions
+ * covered by added, removed or changed commands are redrawn and sent. */
+struct draw_item {
+    mu_Command *cmd; // valid during the frame it was collected in
+    mu_Rect clip;    // clip rect in effect, within the screen
+    mu_Rect bounds;  // pixels the command can touch
+    uint32_t hash;   // type, geometry, color, content and clip
+};
+da_declare(DrawList, struct draw_item);
+da_declare(DamageList, mu_Rect);
+static DrawList draw_lists[2] = {0};
+static int draw_current = 0; // draw list of the previous frame
+static DamageList damage = {0};
+
+#define MAX_DAMAGE_RECTS 16
+// How far ahead a mismatching command is looked for as added or removed.
+#define DIFF_LOOKAHEAD 32
+
+static mu_Rect rect_intersect(mu_Rect a, mu_Rect b) {
+    int x1 = a.x > b.x ? a.x : b.x, y1 = a.y > b.y ? a.y : b.y;
+    int x2 = a.x + a.w < b.x + b.w ? a.x + a.w : b.x + b.w;
+    int y2 = a.y + a.h < b.y + b.h ? a.y + a.h : b.y + b.h;
+    if (x2 < x1) x2 = x1;
+    if (y2 < y1) y2 = y1;
+    return mu_rect(x1, y1, x2 - x1, y2 - y1);
+}
+
+static mu_Rect rect_union(mu_Rect a, mu_Rect b) {
+    int x1 = a.x < b.x ? a.x : b.x, y1 = a.y < b.y ? a.y : b.y;
+    int x2 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+    int y2 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+    return mu_rect(x1, y1, x2 - x1, y2 - y1);
+}
+
+static bool rects_overlap(mu_Rect a, mu_Rect b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static bool rects_touch(mu_Rect a, mu_Rect b) {
+    return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+// Damaged rects are merged with the ones they touch; past MAX_DAMAGE_RECTS
+// everything is merged into a single bounding rect.
+static void add_damage(mu_Rect r) {
+    r = rect_intersect(r, mu_rect(0, 0, Config.width, Config.height));
+    if (r.w <= 0 || r.h <= 0)
+        return;
+    for (size_t i = 0; i < damage.count; i++) {
+        if (rects_touch(damage.items[i], r)) {
+            damage.items[i] = rect_union(damage.items[i], r);
+            return;
+        }
+    }
+    if (damage.count == MAX_DAMAGE_RECTS) {
+        for (size_t i = 1; i < damage.count; i++)
+            r = rect_union(r, damage.items[i]);
+        damage.items[0] = rect_union(damage.items[0], r);
+        damage.count = 1;
+        return;
+    }
+    da_append(&damage, r);
+}
+
+static mu_Rect text_bounds(mu_Vec2 pos, const char *str) {
+    int lines = 1, cols = 0, max_cols = 0;
+    for (; *str; str++) {
+        if (*str == '\n') {
+            lines++;
+            cols = 0;
+        } else if ((*str & 0xc0) != 0x80 && ++cols > max_cols) {
+            max_cols = cols;
+        }
+    }
+    return mu_rect(pos.x, pos.y, max_cols * FONT_SIZE, lines * FONT_SIZE);
+}
+
+static uint32_t draw_item_hash(mu_Command *cmd, mu_Rect clip) {
+    struct {
+        int type;
+        mu_Rect clip, rect;
+        mu_Color color;
+        int id;
+        mu_Font font;
+    } key;
+    const char *str = NULL;
+    memset(&key, 0, sizeof(key));
+    key.type = cmd->type;
+    key.clip = clip;
+    switch (cmd->type) {
+    case MU_COMMAND_RECT:
+        key.rect = cmd->rect.rect;
+        key.color = cmd->rect.color;
+        break;
+    case MU_COMMAND_TEXT:
+        key.rect.x = cmd->text.pos.x;
+        key.rect.y = cmd->text.pos.y;
+        key.color = cmd->text.color;
+        key.font = cmd->text.font;
+        str = cmd->text.str;
+        break;
+    case MU_COMMAND_ICON:
+        key.rect = cmd->icon.rect;
+        key.color = cmd->icon.color;
+        key.id = cmd->icon.id;
+        break;
+    case MU_COMMAND_IMAGE:
+        key.rect = cmd->image.rect;
+        str = cmd->image.path;
+        break;
+    }
+    uint32_t hash = mu_hash(&key, sizeof(key));
+    if (str)
+        hash ^= mu_hash(str, strlen(str)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+static void collect_draw_items(DrawList *list) {
+    mu_Rect screen = mu_rect(0, 0, Config.width, Config.height);
+    mu_Rect clip = screen;
+    mu_Command *cmd = NULL;
+    list->count = 0;
+    while (mu_next_command(&ctx, &cmd)) {
+        struct draw_item item = {.cmd = cmd, .clip = clip};
+        switch (cmd->type) {
+        case MU_COMMAND_CLIP:
+            clip = rect_intersect(cmd->clip.rect, screen);
+            continue;
+        case MU_COMMAND_RECT:
+            item.bounds = cmd->rect.rect;
+            break;
+        case MU_COMMAND_TEXT:
+            item.bounds = text_bounds(cmd->text.pos, cmd->text.str);
+            break;
+        case MU_COMMAND_ICON: // glyphs are centered in the icon rect
+            item.bounds = mu_rect(cmd->icon.rect.x + (cmd->icon.rect.w - 8) / 2,
+                                  cmd->icon.rect.y + (cmd->icon.rect.h - 8) / 2, 8, 8);
+            break;
+        case MU_COMMAND_IMAGE:
+            item.bounds = cmd->image.rect;
+            break;
+        default:
+            continue;
+        }
+        item.bounds = rect_intersect(item.bounds, clip);
+        if (item.bounds.w <= 0 || item.bounds.h <= 0)
+            continue;
+        item.hash = draw_item_hash(cmd, clip);
+        da_append(list, item);
+    }
+}
+
+static bool same_draw_item(struct draw_item *a, struct draw_item *b) {
+    return a->hash == b->hash && a->bounds.x == b->bounds.x && a->bounds.y == b->bounds.y &&
+           a->bounds.w == b->bounds.w && a->bounds.h == b->bounds.h;
+}
+
+// Distance to the next item of `list` from `start` equal to `item`, or
+// DIFF_LOOKAHEAD if there is none close enough.
+static size_t find_draw_item(DrawList *list, size_t start, struct draw_item *item) {
+    for (size_t i = 0; i < DIFF_LOOKAHEAD && start + i < list->count; i++) {
+        if (same_draw_item(&list->items[start + i], item))
+            return i;
+    }
+    return DIFF_LOOKAHEAD;
+}
+
+// Walks both frames in order, matching equal items. Unmatched items are
+// damaged on both sides, so outside the damage every pixel is covered by the
+// same commands in the same order and is unchanged.
+static void diff_draw_lists(DrawList *prev, DrawList *cur) {
+    size_t i = 0, j = 0;
+    while (i < prev->count && j < cur->count) {
+        if (same_draw_item(&prev->items[i], &cur->items[j])) {
+            i++;
+            j++;
+            continue;
+        }
+        size_t added = find_draw_item(cur, j, &prev->items[i]);
+        size_t removed = find_draw_item(prev, i, &cur->items[j]);
+        if (added < DIFF_LOOKAHEAD && added <= removed) {
+            for (; added; added--)
+                add_damage(cur->items[j++].bounds);
+        } else if (removed < DIFF_LOOKAHEAD) {
+            for (; removed; removed--)
+                add_damage(prev->items[i++].bounds);
+        } else {
+            add_damage(prev->items[i++].bounds);
+            add_damage(cur->items[j++].bounds);
+        }
+    }
+    for (; i < prev->count; i++)
+        add_damage(prev->items[i].bounds);
+    for (; j < cur->count; j++)
+        add_damage(cur->items[j].bounds);
+}
+
+void draw_command(mu_Command *cmd) {
+    switch (cmd->type) {
+    case MU_COMMAND_TEXT:
+        draw_text(cmd->text.pos.x, cmd->text.pos.y, cmd->text.str,
+                  toColor(cmd->text.color));
+        break;
+    case MU_COMMAND_RECT:
+        draw_rectangle(cmd->rect.rect.x, cmd->rect.rect.y, cmd->rect.rect.w,
+                       cmd->rect.rect.h, toColor(cmd->rect.color));
+        break;
+    case MU_COMMAND_ICON:
+        draw_icon(cmd->icon.id, cmd->icon.rect, cmd->icon.color);
+        break;
+    case MU_COMMAND_IMAGE: {
+        struct img_data *img = hm_try(&image_cache, cmd->image.path);
+        if (!img) {
+            int x, y, n;
+            unsigned char *rawdata = stbi_load(cmd->image.path, &x, &y, &n, 0);
+            struct img_data data = {.data = rawdata, .width = x, .height = y, .channels = n};
+            hm_set(&image_cache, cmd->image.path, data);
+            img = hm_try(&image_cache, cmd->image.path);
+        }
+        unsigned char *resized = stbir_resize_uint8_linear(img->data, img->width, img->height, 0, NULL, cmd->image.rect.w, cmd->image.rect.h, 0, img->channels);
+        if (!resized) break;
+        draw_image(resized, img->channels, cmd->image.rect.x, cmd->image.rect.y, cmd->image.rect.w, cmd->image.rect.h);
+        stbi_image_free(resized);
+    } break;
+    }
+}
+
+// Redraws the region `r` from scratch with the commands that touch it.
+static void draw_region(DrawList *list, mu_Rect r) {
+    clip_rect.x = r.x;
+    clip_rect.y = r.y;
+    clip_rect.w = r.w;
+    clip_rect.h = r.h;
+    clip_rect.enabled = true;
+    draw_rectangle(r.x, r.y, r.w, r.h, 0);
+    for (size_t i = 0; i < list->count; i++) {
+        struct draw_item *item = &list->items[i];
+        if (!rects_overlap(item->bounds, r))
+            continue;
+        mu_Rect clip = rect_intersect(item->clip, r);
+        clip_rect.x = clip.x;
+        clip_rect.y = clip.y;
+        clip_rect.w = clip.w;
+        clip_rect.h = clip.h;
+        draw_command(item->cmd);
+    }
+}
+
 napi_value handleInputs(napi_env env, napi_callback_info info) {
+    // A frame is due anyway: read the input once it can be shown.
+    if (Config.low_latency && dirty_frames > 0)
+        pace_frame();
     int exit = process_input(&ctx);
 
     napi_value return_value;
@@ -697,9 +2110,58 @@ napi_value handleInputs(napi_env env, napi_callback_info info) {
     return return_value;
 }
 
+napi_value shouldRender(napi_env env, napi_callback_info info) {
+    poll_resize();
+    if (dirty_frames <= 0)
+        latency.input_time = 0; // the input changed nothing on screen
+    return node_bool_to_napi_val(dirty_frames > 0);
+}
+
+// Blocks until input arrives or `timeout` ms pass: an idle UI wakes up as soon
+// as there's input to handle.
+napi_value waitInput(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    int timeout = 0;
+    napi_get_value_int32(env, args[0], &timeout);
+    if (recording.replaying || pending_input.len)
+        return NULL;
+    struct pollfd fd = {.fd = STDIN_FILENO, .events = POLLIN};
+    if (poll(&fd, 1, timeout) > 0 && !latency.input_time)
+        latency.input_time = get_time_sec();
+    return NULL;
+}
+
+// Called on SIGWINCH; the new size is read once they stop coming.
+napi_value windowResized(napi_env env, napi_callback_info info) {
+    if (recording.replaying)
+        return NULL;
+    resize_time = get_time_sec();
+    return NULL;
+}
+
+// MU_KEY_* bits of the keys pressed since the last frame, and held down.
+napi_value keyPressed(napi_env env, napi_callback_info info) {
+    napi_value result;
+    napi_create_int32(env, ctx.key_pressed, &result);
+    return result;
+}
+
+napi_value keyDown(napi_env env, napi_callback_info info) {
+    napi_value result;
+    napi_create_int32(env, ctx.key_down, &result);
+    return result;
+}
+
+napi_value invalidate(napi_env env, napi_callback_info info) {
+    mark_dirty();
+    return NULL;
+}
+
 napi_value muBegin(napi_env env, napi_callback_info info) {
-    struct winsize ts = get_terminal_size();
-    updateWindowSize(ts.ws_col, ts.ws_row - 1);
+    poll_resize();
+    updateWindowSize(term_size.ws_col, term_size.ws_row - 1);
+    if (Config.low_latency)
+        pace_frame();
     mu_begin(&ctx);
     return NULL;
 }
@@ -707,42 +2169,35 @@ napi_value muBegin(napi_env env, napi_callback_info info) {
 napi_value muEnd(napi_env env, napi_callback_info info) {
     mu_end(&ctx);
 
-    mu_Command *cmd = NULL;
-    while (mu_next_command(&ctx, &cmd)) {
-        switch (cmd->type) {
-        case MU_COMMAND_TEXT:
-            draw_text(cmd->text.pos.x, cmd->text.pos.y, cmd->text.str,
-                      toColor(cmd->text.color));
-            break;
-        case MU_COMMAND_RECT:
-            draw_rectangle(cmd->rect.rect.x, cmd->rect.rect.y, cmd->rect.rect.w,
-                           cmd->rect.rect.h, toColor(cmd->rect.color));
-            break;
-        case MU_COMMAND_ICON:
-            draw_icon(cmd->icon.id, cmd->icon.rect, cmd->icon.color);
-            break;
-        case MU_COMMAND_CLIP:
-            set_clip_rect(cmd->clip.rect.x, cmd->clip.rect.y,
-                          cmd->clip.rect.w, cmd->clip.rect.h);
-            break;
-        case MU_COMMAND_IMAGE: {
-            struct img_data *img = hm_try(&image_cache, cmd->image.path);
-            if (!img) {
-                int x, y, n;
-                unsigned char *rawdata = stbi_load(cmd->image.path, &x, &y, &n, 0);
-                struct img_data data = {.data = rawdata, .width = x, .height = y, .channels = n};
-                hm_set(&image_cache, cmd->image.path, data);
-                img = hm_try(&image_cache, cmd->image.path);
-            }
-            unsigned char *resized = stbir_resize_uint8_linear(img->data, img->width, img->height, 0, NULL, cmd->image.rect.w, cmd->image.rect.h, 0, img->channels);
-            if (!resized) break;
-            draw_image(resized, img->channels, cmd->image.rect.x, cmd->image.rect.y, cmd->image.rect.w, cmd->image.rect.h);
-            stbi_image_free(resized);
-        } break;
-        }
+    DrawList *prev = &draw_lists[draw_current];
+    DrawList *cur = &draw_lists[draw_current ^ 1];
+    collect_draw_items(cur);
+    damage.count = 0;
+    if (frame_number == 0)
+        add_damage(mu_rect(0, 0, Config.width, Config.height));
+    else
+        diff_draw_lists(prev, cur);
+    draw_current ^= 1;
+
+    for (size_t i = 0; i < damage.count; i++)
+        draw_region(cur, damage.items[i]);
+    clip_rect.enabled = false;
+
+    // Ghostty can't edit a frame in place: the whole image is sent again.
+    if (damage.count && (frame_number == 0 || Config.ghostty_mode)) {
+        kitty_update_display();
+    } else if (damage.count) {
+        for (size_t i = 0; i < damage.count; i++)
+            kitty_update_region(damage.items[i]);
+        kitty_show_frame();
     }
-    kitty_update_display();
-    limit_fps();
+    sample_latency(damage.count > 0);
+    record_frame();
+    if (dirty_frames > 0)
+        dirty_frames--;
+    // Replays run as fast as they can.
+    if (!recording.replaying)
+        limit_fps();
     return NULL;
 }
 
@@ -757,6 +2212,7 @@ napi_value muBeginTreeNode(napi_env env, napi_callback_info info) {
         opt = MU_OPT_EXPANDED;
     }
 
+    set_next_hash(env, args, argc, 2);
     int open = mu_begin_treenode_ex(&ctx, text, opt);
     return node_bool_to_napi_val(open != 0);
 }
@@ -777,6 +2233,7 @@ napi_value muHeader(napi_env env, napi_callback_info info) {
         opt = MU_OPT_EXPANDED;
     }
 
+    set_next_hash(env, args, argc, 2);
     int open = mu_header_ex(&ctx, text, opt);
     return node_bool_to_napi_val(open != 0);
 }
@@ -795,13 +2252,121 @@ napi_value muEndPanel(napi_env env, napi_callback_info info) {
     return NULL;
 }
 
+// Reads an optional string property of the init() options object, truncated
+// to `size`.
+static void get_string_option(napi_env env, napi_value options, const char *name, char *buf, size_t size) {
+    bool has = false;
+    napi_value prop;
+    napi_has_named_property(env, options, name, &has);
+    if (!has) return;
+    napi_get_named_property(env, options, name, &prop);
+    napi_get_value_string_utf8(env, prop, buf, size, NULL);
+}
+
+// Reads an optional boolean property of the init() options object.
+static void get_bool_option(napi_env env, napi_value options, const char *name, bool *value) {
+    bool has = false;
+    napi_value prop;
+    napi_has_named_property(env, options, name, &has);
+    if (!has) return;
+    napi_get_named_property(env, options, name, &prop);
+    napi_get_value_bool(env, prop, value);
+}
+
+// Reads an optional integer property of the init() options object.
+static void get_int_option(napi_env env, napi_value options, const char *name, int *value) {
+    bool has = false;
+    napi_value prop;
+    napi_has_named_property(env, options, name, &has);
+    if (!has) return;
+    napi_get_named_property(env, options, name, &prop);
+    napi_get_value_int32(env, prop, value);
+}
+
 napi_value initWindow(napi_env env, napi_callback_info info) {
     node_parse_args();
-    mu_init(&ctx);
+    // microui capacities; anything left at 0 keeps the microui default.
+    mu_Config config = {0};
+    char record_path[1024] = "", replay_path[1024] = "";
+    int max_fps = 0;
+    napi_valuetype type = napi_undefined;
+    if (argc)
+        napi_typeof(env, args[0], &type);
+    if (type == napi_object) {
+        get_int_option(env, args[0], "rootListSize", &config.root_list_size);
+        get_int_option(env, args[0], "containerStackSize", &config.container_stack_size);
+        get_int_option(env, args[0], "clipStackSize", &config.clip_stack_size);
+        get_int_option(env, args[0], "idStackSize", &config.id_stack_size);
+        get_int_option(env, args[0], "layoutStackSize", &config.layout_stack_size);
+        get_int_option(env, args[0], "maxWidths", &config.max_widths);
+        get_int_option(env, args[0], "containerPoolSize", &config.container_pool_size);
+        get_int_option(env, args[0], "treenodePoolSize", &config.treenode_pool_size);
+        get_int_option(env, args[0], "layoutCacheSize", &config.layout_cache_size);
+        get_int_option(env, args[0], "textCacheSize", &config.text_cache_size);
+
+        get_int_option(env, args[0], "downscale", &Config.downscale);
+        get_bool_option(env, args[0], "lowLatency", &Config.low_latency);
+        get_int_option(env, args[0], "maxFps", &max_fps);
+
+        get_string_option(env, args[0], "record", record_path, sizeof(record_path));
+        get_string_option(env, args[0], "replay", replay_path, sizeof(replay_path));
+
+        char motion[16] = "";
+        get_string_option(env, args[0], "motion", motion, sizeof(motion));
+        if (!strcmp(motion, "drag"))
+            Config.motion = MOTION_DRAG;
+        else if (!strcmp(motion, "all"))
+            Config.motion = MOTION_ALL;
+    }
+    mu_init_ex(&ctx, &config);
     ctx.text_width = getTextWidth;
     ctx.text_height = getTextHeight;
-    init_config();
-    enable_raw_mode();
+    ctx.text_advance = FONT_SIZE; // the C64 font is monospace
+    if (max_fps <= 0)
+        max_fps = Config.low_latency ? LOW_LATENCY_FPS : TARGET_FPS;
+    Config.frame_time = 1.0 / max_fps;
+    term_out = stdout;
+    if (replay_path[0]) {
+        start_replay(replay_path);
+    } else {
+        init_config();
+        enable_raw_mode();
+    }
+    read_terminal_size();
+    resize_time = 0;
+    if (record_path[0] && !replay_path[0])
+        start_recording(record_path, &term_size);
+    return NULL;
+}
+
+napi_value allocWidget(napi_env env, napi_callback_info info) {
+    struct widget_slot *slot = calloc(1, sizeof(*slot));
+    int index;
+    if (free_slots.count) {
+        index = da_pop(&free_slots);
+        widget_slots.items[index] = slot;
+    } else {
+        index = widget_slots.count;
+        da_append(&widget_slots, slot);
+    }
+    napi_value result;
+    napi_create_int32(env, index, &result);
+    return result;
+}
+
+napi_value freeWidget(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot)
+        return NULL;
+    int index;
+    napi_get_value_int32(env, args[0], &index);
+    free(slot->text);
+    text_log_free(slot->log);
+    data_table_free(slot->table);
+    free(slot);
+    widget_slots.items[index] = NULL;
+    da_append(&free_slots, index);
     return NULL;
 }
 
@@ -811,7 +2376,470 @@ napi_value closeWindow(napi_env env, napi_callback_info info) {
         fb = NULL;
     }
     hm_free(&image_cache);
-    disable_raw_mode();
+    da_free(&size_stack);
+    da_free(&draw_lists[0]);
+    da_free(&draw_lists[1]);
+    da_free(&damage);
+    free_glyph_pages();
+    da_free(&pending_input.paste);
+    pending_input.pasting = false;
+    mu_free(&ctx);
+    if (!recording.replaying)
+        disable_raw_mode();
+    stop_recording();
+    return NULL;
+}
+
+static void set_stat(napi_env env, napi_value stats, const char *name, int value) {
+    napi_value v;
+    napi_create_int32(env, value, &v);
+    napi_set_named_property(env, stats, name, v);
+}
+
+static int compare_float(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Memory counters, useful to size the init() options: each microui stack and
+// pool reports its capacity and the highest use seen so far. The command list
+// grows in chunks and keeps them across frames. Then the frame counters and
+// the input latencies.
+napi_value muStats(napi_env env, napi_callback_info info) {
+    napi_value result;
+    napi_create_object(env, &result);
+    set_stat(env, result, "commandListSize", ctx.command_list.capacity);
+    set_stat(env, result, "commandListUsed", ctx.command_list.used);
+    set_stat(env, result, "commandListPeak", ctx.command_list.peak);
+    set_stat(env, result, "rootListSize", ctx.root_list.cap);
+    set_stat(env, result, "rootListPeak", ctx.root_list.peak);
+    set_stat(env, result, "containerStackSize", ctx.container_stack.cap);
+    set_stat(env, result, "containerStackPeak", ctx.container_stack.peak);
+    set_stat(env, result, "clipStackSize", ctx.clip_stack.cap);
+    set_stat(env, result, "clipStackPeak", ctx.clip_stack.peak);
+    set_stat(env, result, "idStackSize", ctx.id_stack.cap);
+    set_stat(env, result, "idStackPeak", ctx.id_stack.peak);
+    set_stat(env, result, "layoutStackSize", ctx.layout_stack.cap);
+    set_stat(env, result, "layoutStackPeak", ctx.layout_stack.peak);
+    set_stat(env, result, "containerPoolSize", ctx.container_pool.len);
+    set_stat(env, result, "containerPoolPeak", ctx.container_pool.peak);
+    set_stat(env, result, "treenodePoolSize", ctx.treenode_pool.len);
+    set_stat(env, result, "treenodePoolPeak", ctx.treenode_pool.peak);
+    set_stat(env, result, "layoutCacheSize", ctx.layout_cache_pool.len);
+    set_stat(env, result, "layoutCachePeak", ctx.layout_cache_pool.peak);
+    set_stat(env, result, "textCacheSize", ctx.text_cache_pool.len);
+    set_stat(env, result, "textCachePeak", ctx.text_cache_pool.peak);
+    set_stat(env, result, "frames", recording.frames);
+    set_stat(env, result, "replayMismatches", recording.mismatches);
+
+    // Input to screen latency percentiles of the latest frames, in
+    // microseconds.
+    static float sorted[LATENCY_SAMPLES];
+    int n = latency.count < LATENCY_SAMPLES ? latency.count : LATENCY_SAMPLES;
+    memcpy(sorted, latency.samples, n * sizeof(float));
+    qsort(sorted, n, sizeof(float), compare_float);
+    set_stat(env, result, "inputLatencySamples", latency.count);
+    set_stat(env, result, "inputLatencyP50", n ? sorted[n / 2] * 1000000 : 0);
+    set_stat(env, result, "inputLatencyP90", n ? sorted[n * 9 / 10] * 1000000 : 0);
+    set_stat(env, result, "inputLatencyP99", n ? sorted[n * 99 / 100] * 1000000 : 0);
+    set_stat(env, result, "inputLatencyMax", n ? sorted[n - 1] * 1000000 : 0);
+    return result;
+}
+
+napi_value muBeginList(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    char title[MAX_STR_LEN];
+    node_get_string(0, title);
+    int count = 0, item_height = 0, overscan = 0;
+    napi_get_value_int32(env, args[1], &count);
+    napi_get_value_int32(env, args[2], &item_height);
+    if (argc > 3)
+        napi_get_value_int32(env, args[3], &overscan);
+    if (item_height <= 0)
+        item_height = ctx.style->size.y + ctx.style->padding * 2;
+
+    mu_begin_panel(&ctx, title);
+    // Scroll and body are up to date here: the panel clamps its scroll while
+    // laying out the scrollbars.
+    mu_Container *cnt = mu_get_current_container(&ctx);
+    struct list_state list = {count, item_height, item_height + ctx.style->spacing};
+    int view = cnt->body.h - ctx.style->padding * 2;
+    int first = cnt->scroll.y / list.pitch - overscan;
+    int last = (cnt->scroll.y + view) / list.pitch + 1 + overscan;
+    first = mu_clamp(first, 0, count);
+    last = mu_clamp(last, first, count);
+    da_append(&list_stack, list);
+
+    napi_value result, first_val, last_val;
+    napi_create_array_with_length(env, 2, &result);
+    napi_create_int32(env, first, &first_val);
+    napi_create_int32(env, last, &last_val);
+    napi_set_element(env, result, 0, first_val);
+    napi_set_element(env, result, 1, last_val);
+    return result;
+}
+
+napi_value muBeginListItem(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    int index = 0;
+    napi_get_value_int32(env, args[0], &index);
+    struct list_state *list = &list_stack.items[list_stack.count - 1];
+    int width = ctx.layout_stack.items[ctx.layout_stack.idx - 1].body.w;
+
+    // Place the row at its absolute offset so skipped rows cost nothing.
+    mu_layout_set_next(&ctx, mu_rect(0, index * list->pitch, width, list->item_height), 1);
+    mu_layout_begin_column(&ctx);
+    width = -1;
+    mu_layout_row(&ctx, 1, &width, list->item_height);
+    return NULL;
+}
+
+napi_value muEndListItem(napi_env env, napi_callback_info info) {
+    mu_layout_end_column(&ctx);
+    return NULL;
+}
+
+napi_value muEndList(napi_env env, napi_callback_info info) {
+    struct list_state list = da_pop(&list_stack);
+    // Reserve the height of all rows so the panel scrollbar covers the list.
+    if (list.count > 0) {
+        int height = list.count * list.pitch - ctx.style->spacing;
+        mu_layout_set_next(&ctx, mu_rect(0, 0, 1, height), 1);
+        mu_layout_next(&ctx);
+    }
+    mu_end_panel(&ctx);
+    return NULL;
+}
+
+napi_value muLog(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot)
+        return NULL;
+    int capacity = 0;
+    if (argc > 1)
+        napi_get_value_int32(env, args[1], &capacity);
+    struct text_log *log = widget_slot_log(slot, capacity);
+
+    mu_push_id(&ctx, &slot, sizeof(slot));
+    mu_begin_panel(&ctx, "!log");
+    mu_Container *cnt = mu_get_current_container(&ctx);
+    mu_Font font = ctx.style->font;
+    int padding = ctx.style->padding;
+    int line_height = ctx.text_height(font);
+    int content = log->count * line_height;
+    int view = cnt->body.h - padding * 2;
+    int max_scroll = mu_max(content - view, 0);
+
+    // Keep following the tail unless the user scrolled up.
+    if (cnt->scroll.y >= log->last_max)
+        cnt->scroll.y = max_scroll;
+    log->last_max = max_scroll;
+
+    // Only the visible lines are drawn; the panel clip handles partial ones.
+    int first = mu_clamp(cnt->scroll.y / line_height, 0, log->count);
+    int last = mu_clamp((cnt->scroll.y + view) / line_height + 1, first, log->count);
+    int x = cnt->body.x + padding;
+    int y = cnt->body.y + padding - cnt->scroll.y;
+    mu_Color color = ctx.style->colors[MU_COLOR_TEXT];
+    for (int i = first; i < last; i++) {
+        const char *line = log->lines[(log->head + i) % log->capacity];
+        mu_draw_text(&ctx, font, line, -1, mu_vec2(x, y + i * line_height), color);
+    }
+
+    // Reserve the height of all lines so the scrollbar covers the log.
+    if (content > 0) {
+        mu_layout_set_next(&ctx, mu_rect(0, 0, 1, content), 1);
+        mu_layout_next(&ctx);
+    }
+    mu_end_panel(&ctx);
+    mu_pop_id(&ctx);
+    return NULL;
+}
+
+napi_value logAppend(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    mark_dirty();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot)
+        return NULL;
+    struct text_log *log = widget_slot_log(slot, 0);
+
+    // A whole batch per call: a string (split on newlines) or an array of lines.
+    bool is_array = false;
+    napi_is_array(env, args[1], &is_array);
+    if (is_array) {
+        uint32_t length;
+        napi_get_array_length(env, args[1], &length);
+        for (uint32_t i = 0; i < length; i++) {
+            napi_value line;
+            napi_get_element(env, args[1], i, &line);
+            text_log_append_value(env, log, line);
+        }
+    } else {
+        text_log_append_value(env, log, args[1]);
+    }
+    return NULL;
+}
+
+napi_value logClear(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    mark_dirty();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot || !slot->log)
+        return NULL;
+    int capacity = slot->log->capacity;
+    text_log_free(slot->log);
+    slot->log = NULL;
+    widget_slot_log(slot, capacity);
+    return NULL;
+}
+
+napi_value tableSetColumns(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    mark_dirty();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot)
+        return NULL;
+    uint32_t count = 0;
+    napi_get_array_length(env, args[1], &count);
+    char **titles = malloc(count * sizeof(char *));
+    for (uint32_t c = 0; c < count; c++) {
+        napi_value title;
+        size_t len = 0;
+        napi_get_element(env, args[1], c, &title);
+        if (napi_get_value_string_utf8(env, title, NULL, 0, &len) != napi_ok)
+            len = 0;
+        titles[c] = malloc(len + 1);
+        titles[c][0] = '\0';
+        napi_get_value_string_utf8(env, title, titles[c], len + 1, NULL);
+    }
+    data_table_set_columns(widget_slot_table(slot), count, titles);
+    free(titles);
+    return NULL;
+}
+
+napi_value tableSetRowCount(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    mark_dirty();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    int rows = 0;
+    if (!slot || napi_get_value_int32(env, args[1], &rows) != napi_ok || rows < 0)
+        return NULL;
+    data_table_set_row_count(widget_slot_table(slot), rows);
+    return NULL;
+}
+
+// tableSetColumn(slot, column, values, offset = 0): write a run of cells of a
+// column, growing the table if needed. Values are an array of numbers or
+// strings, or a Float64Array for numeric columns.
+napi_value tableSetColumn(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    mark_dirty();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot)
+        return NULL;
+    struct data_table *table = widget_slot_table(slot);
+    int column = 0, offset = 0;
+    napi_get_value_int32(env, args[1], &column);
+    if (argc > 3)
+        napi_get_value_int32(env, args[3], &offset);
+    if (column < 0 || column >= table->column_count || offset < 0)
+        return NULL;
+    struct table_column *col = &table->columns[column];
+
+    bool is_typedarray = false;
+    napi_typedarray_type type;
+    double *typed = NULL;
+    uint32_t count = 0;
+    napi_is_typedarray(env, args[2], &is_typedarray);
+    if (is_typedarray) {
+        size_t length;
+        void *data;
+        napi_get_typedarray_info(env, args[2], &type, &length, &data, NULL, NULL);
+        if (type != napi_float64_array)
+            return NULL;
+        typed = data;
+        count = length;
+    } else if (napi_get_array_length(env, args[2], &count) != napi_ok) {
+        return NULL;
+    }
+    if (!count)
+        return NULL;
+
+    napi_value first;
+    napi_valuetype first_type = napi_number;
+    if (!typed) {
+        napi_get_element(env, args[2], 0, &first);
+        napi_typeof(env, first, &first_type);
+    }
+    if (!col->typed) {
+        col->numeric = first_type == napi_number;
+        col->typed = true;
+    }
+    if (offset + (int)count > table->row_count)
+        data_table_set_row_count(table, offset + count);
+
+    char buf[MAX_STR_LEN];
+    for (uint32_t i = 0; i < count; i++) {
+        int row = offset + i;
+        double number = 0;
+        napi_value value = NULL;
+        napi_valuetype value_type = napi_number;
+        if (typed) {
+            number = typed[i];
+        } else {
+            napi_get_element(env, args[2], i, &value);
+            napi_typeof(env, value, &value_type);
+            if (value_type == napi_number)
+                napi_get_value_double(env, value, &number);
+        }
+        if (col->numeric) {
+            if (value_type == napi_string) {
+                napi_get_value_string_utf8(env, value, buf, sizeof(buf), NULL);
+                number = strtod(buf, NULL);
+            }
+            col->numbers[row] = number;
+        } else {
+            size_t len = 0;
+            if (value_type == napi_string) {
+                napi_get_value_string_utf8(env, value, NULL, 0, &len);
+                free(col->strings[row]);
+                col->strings[row] = malloc(len + 1);
+                napi_get_value_string_utf8(env, value, col->strings[row], len + 1, NULL);
+            } else {
+                free(col->strings[row]);
+                col->strings[row] = NULL;
+                if (value_type == napi_number) {
+                    snprintf(buf, sizeof(buf), "%.12g", number);
+                    col->strings[row] = strdup(buf);
+                }
+            }
+        }
+        table_column_fit(col, table_cell_text(col, row, buf, sizeof(buf)));
+    }
+    table->order_dirty = true;
+    return NULL;
+}
+
+napi_value tableSort(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    mark_dirty();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot)
+        return NULL;
+    struct data_table *table = widget_slot_table(slot);
+    int column = -1;
+    bool desc = false;
+    napi_get_value_int32(env, args[1], &column);
+    if (argc > 2)
+        napi_get_value_bool(env, args[2], &desc);
+    table->sort_column = column < table->column_count ? column : -1;
+    table->sort_desc = desc;
+    table->order_dirty = true;
+    return NULL;
+}
+
+napi_value muTable(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    struct widget_slot *slot = get_widget_slot(env, args[0]);
+    if (!slot)
+        return NULL;
+    struct data_table *table = widget_slot_table(slot);
+    mu_Font font = ctx.style->font;
+    int padding = ctx.style->padding;
+    int row_height = 0;
+    if (argc > 1)
+        napi_get_value_int32(env, args[1], &row_height);
+    if (row_height <= 0)
+        row_height = ctx.text_height(font) + padding;
+    int header_height = ctx.text_height(font) + padding * 2;
+
+    if (table->order_dirty)
+        data_table_sort(table);
+
+    mu_push_id(&ctx, &slot, sizeof(slot));
+    mu_Rect r = mu_layout_next(&ctx);
+    // Same container as the body panel below, to align the header with its
+    // horizontal scroll.
+    mu_Container *cnt = mu_get_container(&ctx, "!table");
+    int content_width = 0;
+    for (int c = 0; c < table->column_count; c++)
+        content_width += table->columns[c].width + padding * 2;
+
+    // Header: clicking a column title sorts by it, clicking again reverses.
+    mu_Rect header = mu_rect(r.x, r.y, r.w, header_height);
+    mu_push_clip_rect(&ctx, header);
+    int x = header.x - cnt->scroll.x;
+    for (int c = 0; c < table->column_count; c++) {
+        struct table_column *col = &table->columns[c];
+        mu_Rect cell = mu_rect(x, header.y, col->width + padding * 2, header.h);
+        mu_Id id = mu_get_id(&ctx, &c, sizeof(c));
+        mu_update_control(&ctx, id, cell, 0);
+        if (ctx.mouse_pressed == MU_MOUSE_LEFT && ctx.focus == id) {
+            table->sort_desc = table->sort_column == c && !table->sort_desc;
+            table->sort_column = c;
+            data_table_sort(table);
+        }
+        mu_draw_control_frame(&ctx, id, cell, MU_COLOR_BUTTON, 0);
+        mu_draw_control_text(&ctx, col->title, cell, MU_COLOR_TEXT, 0);
+        if (table->sort_column == c) {
+            mu_Rect icon = mu_rect(cell.x + cell.w - header.h, cell.y, header.h, header.h);
+            mu_draw_icon(&ctx, table->sort_desc ? MU_ICON_EXPANDED : MU_ICON_COLLAPSED,
+                         icon, ctx.style->colors[MU_COLOR_TEXT]);
+        }
+        x += cell.w;
+    }
+    mu_pop_clip_rect(&ctx);
+
+    // Body: only the rows inside the visible area are drawn.
+    mu_layout_set_next(&ctx, mu_rect(r.x, r.y + header_height, r.w, r.h - header_height), 0);
+    mu_begin_panel(&ctx, "!table");
+    int view = cnt->body.h - padding * 2;
+    int first = mu_clamp(cnt->scroll.y / row_height, 0, table->row_count);
+    int last = mu_clamp((cnt->scroll.y + view) / row_height + 1, first, table->row_count);
+    int y = cnt->body.y + padding - cnt->scroll.y;
+    mu_Color color = ctx.style->colors[MU_COLOR_TEXT];
+    char buf[MAX_STR_LEN];
+    for (int i = first; i < last; i++) {
+        int row = table->order[i];
+        x = cnt->body.x - cnt->scroll.x;
+        for (int c = 0; c < table->column_count; c++) {
+            struct table_column *col = &table->columns[c];
+            mu_Rect cell = mu_rect(x, y + i * row_height, col->width + padding * 2, row_height);
+            mu_push_clip_rect(&ctx, cell);
+            mu_draw_text(&ctx, font, table_cell_text(col, row, buf, sizeof(buf)), -1,
+                         mu_vec2(cell.x + padding, cell.y + (row_height - ctx.text_height(font)) / 2),
+                         color);
+            mu_pop_clip_rect(&ctx);
+            x += cell.w;
+        }
+    }
+    // Reserve the size of the whole table so the scrollbars cover all rows.
+    if (table->row_count > 0) {
+        mu_layout_set_next(&ctx, mu_rect(0, 0, content_width - padding * 2,
+                                         table->row_count * row_height), 1);
+        mu_layout_next(&ctx);
+    }
+    mu_end_panel(&ctx);
+    mu_pop_id(&ctx);
+    return NULL;
+}
+
+// Cached region of widgets, keyed by a caller id and replayed from its last
+// recording while `version` and the layout around it don't change. Returns
+// true when replayed: the widgets must then be skipped, without endCached().
+napi_value muBeginCached(napi_env env, napi_callback_info info) {
+    node_parse_args();
+    int key, version;
+    napi_get_value_int32(env, args[0], &key);
+    napi_get_value_int32(env, args[1], &version);
+    mu_Id id = mu_get_id(&ctx, &key, sizeof(key));
+    return node_bool_to_napi_val(mu_begin_cached(&ctx, id, version));
+}
+
+napi_value muEndCached(napi_env env, napi_callback_info info) {
+    mu_end_cached(&ctx);
     return NULL;
 }
 
@@ -824,8 +2852,6 @@ napi_value muImage(napi_env env, napi_callback_info info) {
 }
 
 #define get_layout_size(ctx) ((ctx)->layout_stack.items[(ctx)->layout_stack.idx - 1].size)
-static mu_Vec2 layout_stack[64];
-int ls_idx = 0;
 napi_value muBeginLayout(napi_env env, napi_callback_info info) {
     node_parse_args();
     int w, h;
@@ -833,23 +2859,30 @@ napi_value muBeginLayout(napi_env env, napi_callback_info info) {
     napi_get_value_int32(env, args[1], &h);
 
     mu_Vec2 size = get_layout_size(&ctx);
-    layout_stack[ls_idx++] = size;
+    da_append(&size_stack, size);
     if (w) mu_layout_width(&ctx, w);
     if (h) mu_layout_height(&ctx, h);
     return NULL;
 }
 
 napi_value muEndLayout(napi_env env, napi_callback_info info) {
-    mu_Vec2 size = layout_stack[--ls_idx];
+    mu_Vec2 size = da_pop(&size_stack);
     mu_layout_width(&ctx, size.x);
     mu_layout_height(&ctx, size.y);
     return NULL;
 }
 
 napi_value Init(napi_env env, napi_value exports) {
+    term_out = stdout;
     node_export_fn("init", initWindow);
     node_export_fn("close", closeWindow);
     node_export_fn("handleInputs", handleInputs);
+    node_export_fn("shouldRender", shouldRender);
+    node_export_fn("windowResized", windowResized);
+    node_export_fn("waitInput", waitInput);
+    node_export_fn("keyPressed", keyPressed);
+    node_export_fn("keyDown", keyDown);
+    node_export_fn("invalidate", invalidate);
     node_export_fn("begin", muBegin);
     node_export_fn("end", muEnd);
     node_export_fn("beginWindow", muBeginWindow);
@@ -872,6 +2905,24 @@ napi_value Init(napi_env env, napi_value exports) {
     node_export_fn("image", muImage);
     node_export_fn("beginLayout", muBeginLayout);
     node_export_fn("endLayout", muEndLayout);
+    node_export_fn("beginList", muBeginList);
+    node_export_fn("beginListItem", muBeginListItem);
+    node_export_fn("endListItem", muEndListItem);
+    node_export_fn("endList", muEndList);
+    node_export_fn("log", muLog);
+    node_export_fn("logAppend", logAppend);
+    node_export_fn("logClear", logClear);
+    node_export_fn("table", muTable);
+    node_export_fn("tableSetColumns", tableSetColumns);
+    node_export_fn("tableSetColumn", tableSetColumn);
+    node_export_fn("tableSetRowCount", tableSetRowCount);
+    node_export_fn("tableSort", tableSort);
+    node_export_fn("allocWidget", allocWidget);
+    node_export_fn("freeWidget", freeWidget);
+    node_export_fn("stats", muStats);
+    node_export_fn("beginCached", muBeginCached);
+    node_export_fn("endCached", muEndCached);
+    node_export_fn("hash", muHash);
 
     return exports;
 }